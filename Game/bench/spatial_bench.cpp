@@ -0,0 +1,97 @@
+// Spatial hash vs brute force: every enemy tests itself against every projectile
+// (the same shape of work as the player hit tests in main.cpp, at stress-test counts).
+// Entity counts grow while the arena stays the same size, so brute force grows with
+// enemies * projectiles and the grid should grow roughly with enemies + projectiles.
+//
+// Usage: spatial_bench [maxEnemies=10000] [maxProjectiles=100000]
+#include "world/SpatialHash.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr float TileSize = 32.f;
+constexpr float ArenaSize = 512.f * TileSize;
+
+bool overlaps(const sf::FloatRect& a, const sf::FloatRect& b)
+{
+    return a.position.x < b.position.x + b.size.x && b.position.x < a.position.x + a.size.x &&
+           a.position.y < b.position.y + b.size.y && b.position.y < a.position.y + a.size.y;
+}
+
+std::vector<sf::FloatRect> scatter(std::size_t count, float size, std::mt19937& gen)
+{
+    std::uniform_real_distribution<float> dist(0.f, ArenaSize - size);
+    std::vector<sf::FloatRect> boxes;
+    boxes.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        boxes.emplace_back(sf::Vector2f(dist(gen), dist(gen)), sf::Vector2f(size, size));
+    }
+    return boxes;
+}
+
+double millisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::size_t maxEnemies = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000;
+    std::size_t maxProjectiles = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100000;
+
+    std::cout << "Spatial hash vs brute force, " << ArenaSize << "px arena, cell " << TileSize << "px\n";
+
+    game::world::SpatialHash grid(TileSize);
+    bool match = true;
+
+    for (int step = 1; step <= 4; ++step) {
+        std::size_t enemyCount = maxEnemies * step / 4;
+        std::size_t projectileCount = maxProjectiles * step / 4;
+
+        std::mt19937 gen(42);
+        std::vector<sf::FloatRect> enemies = scatter(enemyCount, 32.f, gen);
+        std::vector<sf::FloatRect> projectiles = scatter(projectileCount, 8.f, gen);
+
+        // Brute force: the nested loop main.cpp used to run
+        auto start = std::chrono::steady_clock::now();
+        std::size_t bruteHits = 0;
+        for (const auto& enemy : enemies) {
+            for (const auto& projectile : projectiles) {
+                bruteHits += overlaps(enemy, projectile);
+            }
+        }
+        double bruteMs = millisecondsSince(start);
+
+        // Grid: rebuild from scratch (as every frame does), then one range query per enemy
+        start = std::chrono::steady_clock::now();
+        grid.clear();
+        for (std::size_t i = 0; i < enemies.size(); ++i) {
+            grid.insert(static_cast<std::uint32_t>(i), game::world::SpatialCategory::Enemy, enemies[i]);
+        }
+        for (std::size_t i = 0; i < projectiles.size(); ++i) {
+            grid.insert(static_cast<std::uint32_t>(i), game::world::SpatialCategory::Projectile, projectiles[i]);
+        }
+
+        std::size_t gridHits = 0;
+        for (const auto& enemy : enemies) {
+            grid.query(enemy, game::world::SpatialCategory::Projectile, [&gridHits](std::uint32_t) { ++gridHits; });
+        }
+        double gridMs = millisecondsSince(start);
+
+        match = match && bruteHits == gridHits;
+        std::cout << "  " << enemyCount << " enemies, " << projectileCount << " projectiles"
+                  << " | brute " << bruteMs << " ms"
+                  << " | grid " << gridMs << " ms"
+                  << " | speedup " << bruteMs / gridMs << "x"
+                  << " | hits " << gridHits << (bruteHits == gridHits ? "" : " (MISMATCH)") << "\n";
+    }
+
+    return match ? 0 : 1;
+}
@@ -0,0 +1,68 @@
+#include "BusGraph.hpp"
+
+namespace game::audio {
+
+BusGraph::BusGraph()
+{
+    m_nodes.push_back(Node{});
+}
+
+BusGraph::BusId BusGraph::addBus(BusId parent, float gain)
+{
+    Node node;
+    node.parent = parent;
+    node.gain = gain;
+    node.effective = gain * m_nodes[parent].effective;
+    m_nodes.push_back(node);
+    return static_cast<BusId>(m_nodes.size() - 1);
+}
+
+void BusGraph::setParent(BusId bus, BusId parent)
+{
+    if (bus == Root || parent >= bus) return;
+
+    m_nodes[bus].parent = parent;
+    m_nodes[bus].dirty = true;
+    m_dirty = true;
+}
+
+void BusGraph::setGain(BusId bus, float gain)
+{
+    Node& node = m_nodes[bus];
+    if (node.gain == gain) return;
+
+    node.gain = gain;
+    node.dirty = true;
+    m_dirty = true;
+}
+
+bool BusGraph::flush()
+{
+    if (!m_dirty) {
+        // Changes are only reported by the flush that made them
+        if (m_hasChanges) {
+            for (Node& node : m_nodes) node.changed = false;
+            m_hasChanges = false;
+        }
+        return false;
+    }
+
+    m_hasChanges = false;
+    for (std::size_t i = 0; i < m_nodes.size(); ++i) {
+        Node& node = m_nodes[i];
+        bool parentChanged = i != Root && m_nodes[node.parent].changed;
+        node.changed = false;
+        if (!node.dirty && !parentChanged) continue;
+
+        float effective = i == Root ? node.gain : node.gain * m_nodes[node.parent].effective;
+        node.changed = effective != node.effective;
+        node.effective = effective;
+        node.dirty = false;
+        m_hasChanges = m_hasChanges || node.changed;
+    }
+
+    m_dirty = false;
+    return m_hasChanges;
+}
+
+} // namespace game::audio
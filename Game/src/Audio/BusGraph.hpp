@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace game::audio {
+
+// Tree of gain stages (master -> category -> per-effect). A bus's effective gain is its own
+// gain times its parent's. setGain() only marks the bus; flush() settles every marked subtree
+// in one pass, so any number of changes between flushes costs the same as one.
+class BusGraph {
+public:
+    using BusId = std::uint16_t;
+    static constexpr BusId Root = 0;
+
+    BusGraph();
+
+    BusId addBus(BusId parent, float gain = 1.f);
+    // `parent` must have been added before `bus`
+    void setParent(BusId bus, BusId parent);
+
+    void setGain(BusId bus, float gain);
+    float getGain(BusId bus) const { return m_nodes[bus].gain; }
+
+    // As of the last flush()
+    float getEffectiveGain(BusId bus) const { return m_nodes[bus].effective; }
+    bool hasChanged(BusId bus) const { return m_nodes[bus].changed; }
+
+    // Recompute dirty buses and their children; true if any effective gain changed
+    bool flush();
+
+    bool isDirty() const { return m_dirty; }
+    std::size_t size() const { return m_nodes.size(); }
+
+private:
+    struct Node {
+        BusId parent = Root;
+        float gain = 1.f;
+        float effective = 1.f;
+        bool dirty = false;
+        bool changed = false;
+    };
+
+    // Parents always come before their children, so one forward pass settles the tree
+    std::vector<Node> m_nodes;
+    bool m_dirty = false;
+    bool m_hasChanges = false;
+};
+
+} // namespace game::audio
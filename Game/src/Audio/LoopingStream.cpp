@@ -0,0 +1,95 @@
+#include "LoopingStream.hpp"
+#include "../core/Log.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace game::audio {
+
+LoopingStream::~LoopingStream()
+{
+    // The audio thread reads members of this class, so it has to stop before they go
+    stop();
+}
+
+bool LoopingStream::load(const std::int16_t* samples, std::uint64_t sampleCount, unsigned int channelCount,
+                         unsigned int sampleRate, bool loop)
+{
+    if (!samples || sampleCount == 0 || channelCount == 0 || channelCount > 2 || sampleRate == 0) {
+        GAME_LOG_ERROR("LoopingStream: nothing playable to load");
+        return false;
+    }
+
+    stop();
+    m_samples = samples;
+    m_sampleCount = static_cast<std::size_t>(sampleCount - sampleCount % channelCount);
+    m_channelCount = channelCount;
+    m_position = 0;
+    m_tail.resize(getChunkFrames() * m_channelCount);
+
+    if (channelCount == 1) {
+        initialize(1, sampleRate, {sf::SoundChannel::Mono});
+    } else {
+        initialize(2, sampleRate, {sf::SoundChannel::FrontLeft, sf::SoundChannel::FrontRight});
+    }
+    setLooping(loop);
+    return true;
+}
+
+bool LoopingStream::load(const sf::SoundBuffer& buffer, bool loop)
+{
+    return load(buffer.getSamples(), buffer.getSampleCount(), buffer.getChannelCount(), buffer.getSampleRate(), loop);
+}
+
+void LoopingStream::setChunkFrames(std::size_t frames)
+{
+    frames = std::max<std::size_t>(frames, 64);
+    if (getStatus() == sf::SoundSource::Status::Stopped) {
+        m_tail.resize(frames * m_channelCount);
+    }
+    m_chunkFrames.store(frames, std::memory_order_relaxed);
+}
+
+bool LoopingStream::onGetData(Chunk& data)
+{
+    if (m_sampleCount == 0) return false;
+
+    const std::size_t chunk = getChunkFrames() * m_channelCount;
+    const bool loop = isLooping();
+
+    if (m_position >= m_sampleCount) {
+        if (!loop) return false;
+        m_position = 0;
+    }
+
+    // Common case: hand SFML the source memory directly
+    std::size_t remaining = m_sampleCount - m_position;
+    if (remaining >= chunk || !loop) {
+        data.samples = m_samples + m_position;
+        data.sampleCount = std::min(chunk, remaining);
+        m_position += data.sampleCount;
+        return true;
+    }
+
+    // Loop seam: the end of the buffer and its start go out as one full chunk
+    const std::size_t tailSize = std::min(chunk, m_tail.size());
+    std::size_t filled = 0;
+    while (filled < tailSize) {
+        std::size_t count = std::min(tailSize - filled, m_sampleCount - m_position);
+        std::memcpy(m_tail.data() + filled, m_samples + m_position, count * sizeof(std::int16_t));
+        filled += count;
+        m_position += count;
+        if (m_position == m_sampleCount) m_position = 0;
+    }
+
+    data.samples = m_tail.data();
+    data.sampleCount = tailSize;
+    return true;
+}
+
+void LoopingStream::onSeek(sf::Time timeOffset)
+{
+    auto frame = static_cast<std::size_t>(std::max(0.f, timeOffset.asSeconds()) * static_cast<float>(getSampleRate()));
+    m_position = std::min(frame * m_channelCount, m_sampleCount);
+}
+
+} // namespace game::audio
@@ -0,0 +1,45 @@
+#pragma once
+#include <SFML/Audio.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace game::audio {
+
+// Streams 16-bit PCM that is already in memory (a sound buffer, a sound bank, a capture).
+// Chunks point straight into the source samples; only the chunk that wraps around the loop
+// point is stitched together in a small tail buffer, so the seam never produces a runt chunk.
+// Use sf::SoundStream::setLooping() to turn looping on or off.
+class LoopingStream : public sf::SoundStream {
+public:
+    static constexpr std::size_t DefaultChunkFrames = 4096;
+
+    LoopingStream() = default;
+    ~LoopingStream() override;
+
+    // `samples` are not copied and must outlive playback
+    bool load(const std::int16_t* samples, std::uint64_t sampleCount, unsigned int channelCount,
+              unsigned int sampleRate, bool loop = true);
+    bool load(const sf::SoundBuffer& buffer, bool loop = true);
+
+    // Frames handed to SFML per callback. Smaller chunks commit less audio ahead of the
+    // speaker (lower latency) at the cost of more callbacks. Growing it only takes full
+    // effect while stopped, since the tail buffer can't be reallocated under the audio thread.
+    void setChunkFrames(std::size_t frames);
+    std::size_t getChunkFrames() const { return m_chunkFrames.load(std::memory_order_relaxed); }
+
+protected:
+    bool onGetData(Chunk& data) override;
+    void onSeek(sf::Time timeOffset) override;
+
+private:
+    const std::int16_t* m_samples = nullptr;
+    std::size_t m_sampleCount = 0;
+    unsigned int m_channelCount = 1;
+    std::size_t m_position = 0;                 // Next sample to hand out; audio thread only while playing
+    std::atomic<std::size_t> m_chunkFrames{DefaultChunkFrames};
+    std::vector<std::int16_t> m_tail;           // The chunk that wraps from the end back to the start
+};
+
+} // namespace game::audio
@@ -0,0 +1,516 @@
+#include "MusicEngine.hpp"
+#include "../core/Profiler.hpp"
+#include "../core/Log.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+namespace game::audio {
+
+namespace {
+    // Decoded up front so a track can start, or fade in, without waiting on the disk
+    const sf::Time PrefetchLength = sf::seconds(3.f);
+} // namespace
+
+// One open track: the first seconds live in memory, the rest is decoded from the file on demand.
+// Output is always interleaved stereo.
+class MusicDecoder {
+public:
+    bool open(const std::string& path)
+    {
+        if (!m_file.openFromFile(path)) return false;
+
+        m_channels = m_file.getChannelCount();
+        m_sampleRate = m_file.getSampleRate();
+        if (m_channels == 0 || m_sampleRate == 0) return false;
+
+        m_totalFrames = m_file.getSampleCount() / m_channels;
+        m_headFrames = std::min<std::uint64_t>(m_totalFrames,
+            static_cast<std::uint64_t>(PrefetchLength.asSeconds() * static_cast<float>(m_sampleRate)));
+
+        m_head.resize(static_cast<std::size_t>(m_headFrames * m_channels));
+        std::uint64_t read = 0;
+        while (read < m_head.size()) {
+            std::uint64_t count = m_file.read(m_head.data() + read, m_head.size() - read);
+            if (count == 0) break;
+            read += count;
+        }
+        m_headFrames = read / m_channels;
+        m_head.resize(static_cast<std::size_t>(m_headFrames * m_channels));
+        return m_headFrames > 0;
+    }
+
+    unsigned int getSampleRate() const { return m_sampleRate; }
+
+    void rewind()
+    {
+        // The file only ever serves what comes after the head
+        m_position = 0;
+        m_file.seek(m_headFrames * m_channels);
+    }
+
+    // Fills `frames` stereo frames; fewer only when a non-looping track runs out
+    std::size_t read(std::int16_t* out, std::size_t frames, bool loop)
+    {
+        m_native.resize(frames * m_channels);
+
+        std::size_t written = 0;
+        bool rewound = false;
+        while (written < frames) {
+            std::size_t got = readNative(m_native.data(), frames - written);
+            toStereo(m_native.data(), out + written * 2, got);
+            written += got;
+
+            if (got > 0) rewound = false;
+            if (written < frames) {
+                // A second empty read straight after a rewind means there is nothing to loop
+                if (!loop || rewound) break;
+                rewind();
+                rewound = true;
+            }
+        }
+        return written;
+    }
+
+private:
+    std::size_t readNative(std::int16_t* out, std::size_t frames)
+    {
+        std::size_t done = 0;
+        if (m_position < m_headFrames) {
+            done = static_cast<std::size_t>(std::min<std::uint64_t>(frames, m_headFrames - m_position));
+            std::memcpy(out, m_head.data() + m_position * m_channels, done * m_channels * sizeof(std::int16_t));
+            m_position += done;
+        }
+        if (done < frames && m_position < m_totalFrames) {
+            std::size_t got = static_cast<std::size_t>(
+                m_file.read(out + done * m_channels, (frames - done) * m_channels) / m_channels);
+            if (got == 0) m_position = m_totalFrames;   // Truncated file: treat as the end
+            m_position += got;
+            done += got;
+        }
+        return done;
+    }
+
+    void toStereo(const std::int16_t* in, std::int16_t* out, std::size_t frames) const
+    {
+        if (m_channels == 2) {
+            std::memcpy(out, in, frames * 2 * sizeof(std::int16_t));
+            return;
+        }
+        // Mono is duplicated; anything wider keeps its front pair
+        for (std::size_t i = 0; i < frames; ++i) {
+            const std::int16_t* frame = in + i * m_channels;
+            out[i * 2] = frame[0];
+            out[i * 2 + 1] = m_channels > 1 ? frame[1] : frame[0];
+        }
+    }
+
+    sf::InputSoundFile m_file;
+    std::vector<std::int16_t> m_head;
+    std::vector<std::int16_t> m_native;
+    std::uint64_t m_headFrames = 0;
+    std::uint64_t m_totalFrames = 0;
+    std::uint64_t m_position = 0;      // Frame within the track
+    unsigned int m_channels = 0;
+    unsigned int m_sampleRate = 0;
+};
+
+float MusicEngine::Deck::gainAt(std::uint64_t frame) const
+{
+    if (rampLength == 0 || frame >= rampStart + rampLength) return gainTo;
+    if (frame <= rampStart) return gainFrom;
+    float t = static_cast<float>(frame - rampStart) / static_cast<float>(rampLength);
+    return gainFrom + (gainTo - gainFrom) * t;
+}
+
+MusicEngine::Mixer::Mixer()
+    : m_mix(ChunkFrames * 2)
+    , m_deckSamples(ChunkFrames * 2)
+    , m_output(ChunkFrames * 2)
+{
+}
+
+MusicEngine::Mixer::~Mixer()
+{
+    // The audio thread must be gone before the decks it reads are destroyed
+    stop();
+}
+
+bool MusicEngine::Mixer::setSampleRate(unsigned int sampleRate)
+{
+    if (sampleRate == m_sampleRate) return false;
+
+    stop();
+    initialize(2, sampleRate, {sf::SoundChannel::FrontLeft, sf::SoundChannel::FrontRight});
+    m_sampleRate = sampleRate;
+    return true;
+}
+
+bool MusicEngine::Mixer::onGetData(Chunk& data)
+{
+    GAME_PROFILE_ZONE("MusicEngine::mix");
+
+    // Claim the next chunk of output frames and copy what to play into it
+    std::uint64_t start = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        bool anyAudible = false;
+        for (std::size_t i = 0; i < DeckCount; ++i) {
+            m_reading[i] = decks[i].audible ? decks[i] : Deck{};
+            anyAudible = anyAudible || decks[i].audible;
+        }
+        if (!anyAudible) return false;
+
+        start = clock;
+        clock += ChunkFrames;
+    }
+
+    // Decoding can hit the disk, so it runs without the lock
+    std::fill(m_mix.begin(), m_mix.end(), 0.f);
+    std::array<bool, DeckCount> ranOut{};
+    for (std::size_t d = 0; d < DeckCount; ++d) {
+        const Deck& deck = m_reading[d];
+        if (!deck.decoder) continue;
+
+        std::size_t frames = deck.decoder->read(m_deckSamples.data(), ChunkFrames, deck.loop);
+        for (std::size_t i = 0; i < frames; ++i) {
+            float gain = deck.gainAt(start + i);
+            m_mix[i * 2] += static_cast<float>(m_deckSamples[i * 2]) * gain;
+            m_mix[i * 2 + 1] += static_cast<float>(m_deckSamples[i * 2 + 1]) * gain;
+        }
+        ranOut[d] = frames < ChunkFrames;
+    }
+
+    {
+        // The main thread may have turned a fade around meanwhile, so the live ramp decides
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::size_t d = 0; d < DeckCount; ++d) {
+            Deck& deck = decks[d];
+            if (!m_reading[d].decoder || deck.decoder != m_reading[d].decoder || !deck.audible) continue;
+
+            bool fadedOut = deck.gainTo == 0.f && start + ChunkFrames >= deck.rampStart + deck.rampLength;
+            if (ranOut[d] || fadedOut) {
+                deck.audible = false;
+                deck.finished = true;
+            }
+        }
+    }
+    for (Deck& deck : m_reading) deck.decoder.reset();
+
+    for (std::size_t i = 0; i < m_mix.size(); ++i) {
+        m_output[i] = static_cast<std::int16_t>(std::clamp(m_mix[i], -32768.f, 32767.f));
+    }
+
+    data.samples = m_output.data();
+    data.sampleCount = m_output.size();
+    return true;
+}
+
+void MusicEngine::Mixer::onSeek(sf::Time)
+{
+    // Tracks are positioned per deck; the mixed stream itself is never seeked
+}
+
+MusicEngine::MusicEngine()
+    : m_mixer(std::make_unique<Mixer>())
+{
+}
+
+MusicEngine::~MusicEngine()
+{
+    m_mixer->stop();
+}
+
+bool MusicEngine::setTrack(TrackId track, const std::string& path)
+{
+    if (track >= m_tracks.size()) m_tracks.resize(track + 1);
+    Track& info = m_tracks[track];
+    if (info.path == path && info.failed) return false;
+
+    info.path = path;
+    info.failed = !std::filesystem::exists(path);
+    if (info.failed) {
+        GAME_LOG_ERROR("Music file not found: " << path);
+    }
+    return !info.failed;
+}
+
+bool MusicEngine::isPlayable(TrackId track) const
+{
+    return track < m_tracks.size() && !m_tracks[track].path.empty() && !m_tracks[track].failed;
+}
+
+MusicEngine::Deck* MusicEngine::findDeck(TrackId track)
+{
+    for (Deck& deck : m_mixer->decks) {
+        if (deck.decoder && !deck.finished && deck.track == track) return &deck;
+    }
+    return nullptr;
+}
+
+void MusicEngine::retire(Deck& deck)
+{
+    if (deck.decoder) m_retired.push_back(std::move(deck.decoder));
+    deck = Deck{};
+}
+
+void MusicEngine::releaseRetired()
+{
+    // A count of one means no chunk in flight still reads from it; this is what closes the file
+    m_retired.erase(std::remove_if(m_retired.begin(), m_retired.end(),
+                                   [](const std::shared_ptr<MusicDecoder>& decoder) { return decoder.use_count() == 1; }),
+                    m_retired.end());
+}
+
+MusicEngine::Deck* MusicEngine::findFreeDeck()
+{
+    for (Deck& deck : m_mixer->decks) {
+        if (!deck.decoder) return &deck;
+    }
+    return nullptr;
+}
+
+void MusicEngine::prefetch(TrackId track)
+{
+    if (!isPlayable(track)) return;
+    if (m_loading && m_loadingTrack == track) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mixer->mutex);
+        if (findDeck(track)) return;
+
+        // Never more than two tracks open: an idle prefetch can be replaced, a fade in progress can't
+        if (!findFreeDeck()) {
+            Deck* idle = nullptr;
+            for (Deck& deck : m_mixer->decks) {
+                if (!deck.audible) idle = &deck;
+            }
+            if (!idle) {
+                m_hasQueuedPrefetch = true;
+                m_queuedPrefetch = track;
+                return;
+            }
+            retire(*idle);
+        }
+    }
+
+    if (m_loading) {
+        // One load at a time; the newest request wins once the current one lands
+        m_hasQueuedPrefetch = true;
+        m_queuedPrefetch = track;
+        return;
+    }
+
+    m_loading = true;
+    m_loadingTrack = track;
+    std::string path = m_tracks[track].path;
+    m_loader.submit([this, track, path]() {
+        GAME_PROFILE_ZONE("MusicEngine::prefetch");
+        auto decoder = std::make_unique<MusicDecoder>();
+        if (!decoder->open(path)) {
+            GAME_LOG_ERROR("Failed to open music: " << path);
+            decoder.reset();
+        }
+        std::lock_guard<std::mutex> lock(m_loadMutex);
+        m_loaded.emplace_back(track, std::move(decoder));
+    });
+}
+
+void MusicEngine::play(TrackId track, bool loop)
+{
+    if (!isPlayable(track)) return;
+    m_hasRequest = true;
+    m_request = {track, loop, false, sf::Time::Zero};
+    prefetch(track);
+    tryStartRequest();
+}
+
+void MusicEngine::crossfadeTo(TrackId track, sf::Time duration, bool loop)
+{
+    if (!isPlayable(track)) return;
+    m_hasRequest = true;
+    m_request = {track, loop, true, duration};
+    prefetch(track);
+    tryStartRequest();
+}
+
+bool MusicEngine::tryStartRequest()
+{
+    if (!m_hasRequest) return false;
+    if (!isPlayable(m_request.track)) {
+        m_hasRequest = false;
+        return false;
+    }
+
+    std::shared_ptr<MusicDecoder> rewindDecoder;
+    bool found = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mixer->mutex);
+        Deck* target = findDeck(m_request.track);
+        found = target != nullptr;
+        if (target && !target->audible) rewindDecoder = target->decoder;
+    }
+    if (!found) {
+        // Still loading (a no-op then), or it ran out just now and has to be opened again
+        prefetch(m_request.track);
+        return false;
+    }
+
+    // Seeking can hit the disk, so do it before taking the lock; the deck isn't audible
+    // yet, so the audio thread won't touch it
+    if (rewindDecoder) rewindDecoder->rewind();
+
+    std::unique_lock<std::mutex> lock(m_mixer->mutex);
+    Deck* target = findDeck(m_request.track);
+    if (!target) return false;
+    m_hasRequest = false;
+
+    Deck* current = nullptr;
+    for (Deck& deck : m_mixer->decks) {
+        if (&deck != target && deck.audible) current = &deck;
+    }
+
+    // Already the track heading to full volume: nothing to do
+    if (target->audible && target->gainTo > 0.f && !current) {
+        target->loop = m_request.loop;
+        return true;
+    }
+
+    unsigned int sampleRate = target->decoder->getSampleRate();
+    bool crossfade = m_request.crossfade && current && m_request.duration > sf::Time::Zero &&
+                     sampleRate == m_mixer->getRate() && m_mixer->getStatus() == sf::SoundSource::Status::Playing;
+    if (m_request.crossfade && current && sampleRate != m_mixer->getRate()) {
+        GAME_LOG_WARN("Music sample rates differ (" << m_mixer->getRate() << " vs " << sampleRate
+                      << "), switching without a crossfade");
+    }
+
+    bool wasAudible = target->audible;
+    target->loop = m_request.loop;
+    target->audible = true;
+    target->finished = false;
+
+    if (crossfade) {
+        // Both ramps start on the first output frame not yet claimed by the audio thread and
+        // last exactly `duration` of samples; a track turned around mid-fade continues from its current gain
+        auto length = static_cast<std::uint64_t>(m_request.duration.asSeconds() * static_cast<float>(sampleRate));
+        std::uint64_t start = m_mixer->clock;
+
+        current->gainFrom = current->gainAt(start);
+        current->gainTo = 0.f;
+        current->rampStart = start;
+        current->rampLength = length;
+
+        target->gainFrom = wasAudible ? target->gainAt(start) : 0.f;
+        target->gainTo = 1.f;
+        target->rampStart = start;
+        target->rampLength = length;
+        return true;
+    }
+
+    for (Deck& deck : m_mixer->decks) {
+        if (&deck != target && deck.decoder) retire(deck);
+    }
+    target->gainFrom = target->gainTo = 1.f;
+    target->rampLength = 0;
+
+    // Stopping the stream can wait on the audio thread, which needs the lock
+    lock.unlock();
+    m_mixer->setSampleRate(sampleRate);
+    if (m_mixer->getStatus() != sf::SoundSource::Status::Playing) {
+        m_mixer->play();
+    }
+    return true;
+}
+
+void MusicEngine::stop()
+{
+    m_hasRequest = false;
+    m_hasQueuedPrefetch = false;
+    m_mixer->stop();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mixer->mutex);
+        for (Deck& deck : m_mixer->decks) retire(deck);
+    }
+    releaseRetired();
+}
+
+void MusicEngine::pause()
+{
+    if (m_mixer->getStatus() == sf::SoundSource::Status::Playing) {
+        m_mixer->pause();
+    }
+}
+
+void MusicEngine::resume()
+{
+    if (m_mixer->getStatus() == sf::SoundSource::Status::Paused) {
+        m_mixer->play();
+    }
+}
+
+void MusicEngine::setVolume(float volume)
+{
+    m_mixer->setVolume(volume);
+}
+
+void MusicEngine::update()
+{
+    std::vector<std::pair<TrackId, std::unique_ptr<MusicDecoder>>> loaded;
+    {
+        std::lock_guard<std::mutex> lock(m_loadMutex);
+        loaded.swap(m_loaded);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mixer->mutex);
+
+        // Take tracks that faded out or ended off their decks; their files close below
+        for (Deck& deck : m_mixer->decks) {
+            if (deck.finished) retire(deck);
+        }
+
+        for (auto& [track, decoder] : loaded) {
+            m_loading = false;
+            if (!decoder) {
+                m_tracks[track].failed = true;
+                if (m_hasRequest && m_request.track == track) m_hasRequest = false;
+                continue;
+            }
+            if (Deck* deck = findFreeDeck()) {
+                deck->decoder = std::move(decoder);
+                deck->track = track;
+            }
+        }
+    }
+
+    releaseRetired();
+    tryStartRequest();
+
+    if (m_hasQueuedPrefetch && !m_loading) {
+        m_hasQueuedPrefetch = false;
+        prefetch(m_queuedPrefetch);
+    }
+}
+
+bool MusicEngine::getCurrentTrack(TrackId& track) const
+{
+    std::lock_guard<std::mutex> lock(m_mixer->mutex);
+    for (const Deck& deck : m_mixer->decks) {
+        if (deck.audible && deck.gainTo > 0.f) {
+            track = deck.track;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::size_t MusicEngine::getOpenStreamCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mixer->mutex);
+    return m_retired.size() +
+           static_cast<std::size_t>(std::count_if(m_mixer->decks.begin(), m_mixer->decks.end(),
+                                                  [](const Deck& deck) { return deck.decoder != nullptr; }));
+}
+
+} // namespace game::audio
@@ -0,0 +1,148 @@
+#pragma once
+#include <SFML/Audio.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../core/ThreadPool.hpp"
+
+namespace game::audio {
+
+using TrackId = std::size_t;
+
+class MusicDecoder;
+
+// Plays music through a single output stream that mixes at most two tracks ("decks").
+// A track's file is only opened when it is prefetched or played, and closed again once
+// it has faded out, so idle tracks hold no file handles or stream threads.
+// Prefetching opens the file and decodes its first seconds into memory on a background
+// thread; crossfades ramp both decks per output sample, so their length is exact.
+class MusicEngine {
+public:
+    MusicEngine();
+    ~MusicEngine();
+
+    MusicEngine(const MusicEngine&) = delete;
+    MusicEngine& operator=(const MusicEngine&) = delete;
+
+    // Remember where a track lives; nothing is read until it is needed. False if the file
+    // doesn't exist, in which case the track is skipped until it is given another path.
+    bool setTrack(TrackId track, const std::string& path);
+
+    // Get `track` ready to start without touching the disk on the audio thread
+    void prefetch(TrackId track);
+
+    // Cut straight to `track` (starts as soon as its prefetch is done)
+    void play(TrackId track, bool loop);
+
+    // Fade the current track out while `track` fades in over `duration`
+    void crossfadeTo(TrackId track, sf::Time duration, bool loop);
+
+    void stop();
+    void pause();
+    void resume();
+    void setVolume(float volume);   // 0-100
+
+    // Main thread, once per frame: picks up finished prefetches, starts requests that were
+    // waiting on them and closes tracks that finished fading out
+    void update();
+
+    // The track playing, or fading in, at full volume once any fade completes; false if none
+    bool getCurrentTrack(TrackId& track) const;
+    std::size_t getOpenStreamCount() const;
+
+private:
+    static constexpr std::size_t DeckCount = 2;
+
+    struct Deck {
+        std::shared_ptr<MusicDecoder> decoder;   // Null when the deck is free
+        TrackId track = 0;
+        bool loop = true;
+        bool audible = false;                    // Being mixed into the output
+        bool finished = false;                   // Faded out or ran off the end; closed by update()
+
+        // Linear gain ramp in output frames
+        float gainFrom = 1.f;
+        float gainTo = 1.f;
+        std::uint64_t rampStart = 0;
+        std::uint64_t rampLength = 0;
+
+        float gainAt(std::uint64_t frame) const;
+    };
+
+    // The output stream; onGetData runs on SFML's audio thread
+    class Mixer : public sf::SoundStream {
+    public:
+        Mixer();
+        ~Mixer() override;
+
+        bool setSampleRate(unsigned int sampleRate);   // Stops the stream if the rate changes
+        unsigned int getRate() const { return m_sampleRate; }
+
+        // Guards decks and clock. Never held while decoding: the audio thread copies the
+        // audible decks, decodes from its copies and only locks again to report tracks that ran out.
+        // It only ever reads audible decks, so the main thread may use any other deck's decoder freely.
+        std::mutex mutex;
+        std::array<Deck, DeckCount> decks;
+        std::uint64_t clock = 0;                       // Output frames claimed so far
+
+    protected:
+        bool onGetData(Chunk& data) override;
+        void onSeek(sf::Time timeOffset) override;
+
+    private:
+        static constexpr std::size_t ChunkFrames = 2048;
+
+        unsigned int m_sampleRate = 0;
+        std::array<Deck, DeckCount> m_reading;         // Audio thread's copies of the decks it is mixing
+        std::vector<float> m_mix;
+        std::vector<std::int16_t> m_deckSamples;
+        std::vector<std::int16_t> m_output;
+    };
+
+    struct Request {
+        TrackId track = 0;
+        bool loop = true;
+        bool crossfade = false;
+        sf::Time duration;
+    };
+
+    Deck* findDeck(TrackId track);   // Caller holds the mixer mutex
+    Deck* findFreeDeck();
+    void retire(Deck& deck);         // Caller holds the mixer mutex
+    void releaseRetired();
+    bool tryStartRequest();
+
+    struct Track {
+        std::string path;
+        bool failed = false;   // Missing or undecodable; not retried until the path changes
+    };
+
+    bool isPlayable(TrackId track) const;
+
+    std::vector<Track> m_tracks;
+    std::unique_ptr<Mixer> m_mixer;
+
+    bool m_hasRequest = false;
+    Request m_request;
+    bool m_loading = false;
+    TrackId m_loadingTrack = 0;
+    bool m_hasQueuedPrefetch = false;
+    TrackId m_queuedPrefetch = 0;
+
+    // Decoders taken off a deck; the audio thread may still be reading one for the current
+    // chunk, so they are closed by update() once nothing else holds them
+    std::vector<std::shared_ptr<MusicDecoder>> m_retired;
+
+    std::mutex m_loadMutex;
+    std::vector<std::pair<TrackId, std::unique_ptr<MusicDecoder>>> m_loaded;   // Null decoder = failed
+
+    // Declared last so a prefetch still running finishes before the rest goes away
+    core::ThreadPool m_loader{2};
+};
+
+} // namespace game::audio
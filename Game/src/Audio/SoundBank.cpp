@@ -0,0 +1,355 @@
+#include "SoundBank.hpp"
+#include "../core/Log.hpp"
+#include <SFML/Audio.hpp>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace game::audio {
+
+namespace {
+
+const char Magic[4] = {'G', 'S', 'F', 'X'};
+const std::uint64_t Alignment = 16;
+
+std::uint64_t alignUp(std::uint64_t value)
+{
+    return (value + Alignment - 1) / Alignment * Alignment;
+}
+
+// FNV-1a over everything that decides a bank's contents except the files themselves
+std::uint32_t hashSources(const std::vector<SoundBankSource>& sources)
+{
+    std::uint32_t hash = 2166136261u;
+    auto mix = [&hash](const void* data, std::size_t size) {
+        const auto* bytes = static_cast<const std::uint8_t*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 16777619u;
+        }
+    };
+    for (const SoundBankSource& source : sources) {
+        mix(source.name.c_str(), source.name.size() + 1);
+        mix(source.path.c_str(), source.path.size() + 1);
+        const std::uint8_t conversion[5] = {
+            static_cast<std::uint8_t>(source.sampleRate), static_cast<std::uint8_t>(source.sampleRate >> 8),
+            static_cast<std::uint8_t>(source.sampleRate >> 16), static_cast<std::uint8_t>(source.sampleRate >> 24),
+            static_cast<std::uint8_t>(source.mono)};
+        mix(conversion, sizeof(conversion));
+    }
+    return hash;
+}
+
+// Decode `source` into interleaved 16-bit PCM with its conversions applied
+bool decodeSource(const SoundBankSource& source, std::vector<std::int16_t>& samples,
+                  unsigned int& sampleRate, unsigned int& channelCount)
+{
+    sf::InputSoundFile file;
+    if (!file.openFromFile(source.path)) return false;
+
+    unsigned int fileChannels = file.getChannelCount();
+    unsigned int fileRate = file.getSampleRate();
+    if (fileChannels == 0 || fileRate == 0) return false;
+
+    std::vector<std::int16_t> decoded(static_cast<std::size_t>(file.getSampleCount()));
+    std::uint64_t read = 0;
+    while (read < decoded.size()) {
+        std::uint64_t count = file.read(decoded.data() + read, decoded.size() - read);
+        if (count == 0) break;
+        read += count;
+    }
+    std::size_t frames = static_cast<std::size_t>(read / fileChannels);
+
+    // Anything wider than stereo keeps its front pair
+    channelCount = source.mono ? 1 : std::min(fileChannels, 2u);
+    std::vector<float> planar(frames * channelCount);
+    for (std::size_t i = 0; i < frames; ++i) {
+        const std::int16_t* frame = decoded.data() + i * fileChannels;
+        if (channelCount == 1) {
+            float sum = 0.f;
+            for (unsigned int c = 0; c < fileChannels; ++c) sum += frame[c];
+            planar[i] = sum / static_cast<float>(fileChannels);
+        } else {
+            planar[i * 2] = frame[0];
+            planar[i * 2 + 1] = fileChannels > 1 ? frame[1] : frame[0];
+        }
+    }
+
+    // Only ever resample down; linear interpolation is plenty for short effects
+    sampleRate = source.sampleRate != 0 ? std::min(source.sampleRate, fileRate) : fileRate;
+    std::size_t outFrames = frames;
+    if (sampleRate != fileRate && frames > 0) {
+        outFrames = static_cast<std::size_t>(static_cast<std::uint64_t>(frames) * sampleRate / fileRate);
+    }
+
+    samples.resize(outFrames * channelCount);
+    double step = static_cast<double>(fileRate) / sampleRate;
+    for (std::size_t i = 0; i < outFrames; ++i) {
+        double position = i * step;
+        std::size_t index = static_cast<std::size_t>(position);
+        std::size_t next = std::min(index + 1, frames - 1);
+        float t = static_cast<float>(position - static_cast<double>(index));
+        for (unsigned int c = 0; c < channelCount; ++c) {
+            float a = planar[index * channelCount + c];
+            float b = planar[next * channelCount + c];
+            float value = a + (b - a) * t;
+            samples[i * channelCount + c] = static_cast<std::int16_t>(std::clamp(value, -32768.f, 32767.f));
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+SoundBank::~SoundBank()
+{
+    close();
+}
+
+bool SoundBank::open(const std::string& path)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        GAME_LOG_ERROR("Failed to open sound bank: " << path);
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(file, &fileSize);
+    HANDLE mapping = fileSize.QuadPart > 0 ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+    CloseHandle(file);
+    if (!mapping) {
+        GAME_LOG_ERROR("Failed to map sound bank: " << path);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view) {
+        GAME_LOG_ERROR("Failed to map sound bank: " << path);
+        return false;
+    }
+
+    m_data = static_cast<const std::uint8_t*>(view);
+    m_size = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        GAME_LOG_ERROR("Failed to open sound bank: " << path);
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        GAME_LOG_ERROR("Failed to read sound bank: " << path);
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        GAME_LOG_ERROR("Failed to map sound bank: " << path);
+        return false;
+    }
+
+    // Every byte is about to be copied out, so have the whole blob read in at once
+    madvise(view, static_cast<std::size_t>(info.st_size), MADV_WILLNEED);
+
+    m_data = static_cast<const std::uint8_t*>(view);
+    m_size = static_cast<std::size_t>(info.st_size);
+#endif
+
+    SoundBankHeader header;
+    if (m_size < sizeof(SoundBankHeader)) {
+        GAME_LOG_ERROR("Sound bank is truncated: " << path);
+        close();
+        return false;
+    }
+
+    std::memcpy(&header, m_data, sizeof(SoundBankHeader));
+    if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version) {
+        GAME_LOG_ERROR("Not a supported sound bank (version " << header.version << "): " << path);
+        close();
+        return false;
+    }
+
+    if (m_size < sizeof(SoundBankHeader) + static_cast<std::size_t>(header.entryCount) * sizeof(SoundBankEntry)) {
+        GAME_LOG_ERROR("Sound bank is truncated: " << path);
+        close();
+        return false;
+    }
+
+    const auto* entries = reinterpret_cast<const SoundBankEntry*>(m_data + sizeof(SoundBankHeader));
+    for (std::uint32_t i = 0; i < header.entryCount; ++i) {
+        const SoundBankEntry& entry = entries[i];
+        if (!std::memchr(entry.name, '\0', sizeof(entry.name))) {
+            GAME_LOG_ERROR("Sound bank entry " << i << " has an unterminated name: " << path);
+            close();
+            return false;
+        }
+        // Anything sf::SoundBuffer::loadFromSamples would refuse
+        if ((entry.channelCount != 1 && entry.channelCount != 2) || entry.sampleRate == 0 ||
+            entry.sampleCount == 0 || entry.sampleCount % entry.channelCount != 0) {
+            GAME_LOG_ERROR("Sound bank entry '" << entry.name << "' has an invalid format: " << path);
+            close();
+            return false;
+        }
+    }
+
+    m_entries = entries;
+    m_entryCount = header.entryCount;
+    return true;
+}
+
+void SoundBank::close()
+{
+    if (!m_data) return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(m_data);
+#else
+    munmap(const_cast<std::uint8_t*>(m_data), m_size);
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+    m_entries = nullptr;
+    m_entryCount = 0;
+}
+
+const SoundBankEntry* SoundBank::find(const std::string& name) const
+{
+    for (std::size_t i = 0; i < m_entryCount; ++i) {
+        if (std::strncmp(m_entries[i].name, name.c_str(), sizeof(m_entries[i].name)) == 0) {
+            return &m_entries[i];
+        }
+    }
+    return nullptr;
+}
+
+const std::int16_t* SoundBank::getSamples(const SoundBankEntry& entry) const
+{
+    std::uint64_t bytes = entry.sampleCount * sizeof(std::int16_t);
+    if (!m_data || entry.offset % sizeof(std::int16_t) != 0 || entry.offset > m_size || bytes > m_size - entry.offset) {
+        return nullptr;
+    }
+    return reinterpret_cast<const std::int16_t*>(m_data + entry.offset);
+}
+
+bool SoundBank::isUpToDate(const std::string& path, const std::vector<SoundBankSource>& sources)
+{
+    SoundBankHeader header;
+    std::ifstream file(path, std::ios::binary);
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) return false;
+    if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version ||
+        header.sourceHash != hashSources(sources)) {
+        return false;
+    }
+
+    std::error_code ec;
+    auto bankTime = std::filesystem::last_write_time(path, ec);
+    if (ec) return false;
+
+    // Sources that have gone missing can't be repacked, so they don't make the bank stale
+    for (const SoundBankSource& source : sources) {
+        auto sourceTime = std::filesystem::last_write_time(source.path, ec);
+        if (!ec && sourceTime > bankTime) return false;
+    }
+    return true;
+}
+
+bool SoundBank::write(const std::string& path, const std::vector<SoundBankSource>& sources)
+{
+    std::vector<SoundBankEntry> entries;
+    std::vector<std::vector<std::int16_t>> payloads;
+    for (const SoundBankSource& source : sources) {
+        if (source.name.size() >= sizeof(SoundBankEntry::name)) {
+            GAME_LOG_WARN("Sound bank name too long, skipped: " << source.name);
+            continue;
+        }
+
+        std::vector<std::int16_t> samples;
+        unsigned int sampleRate = 0;
+        unsigned int channelCount = 0;
+        if (!decodeSource(source, samples, sampleRate, channelCount) || samples.empty()) {
+            GAME_LOG_WARN("Failed to decode " << source.path << ", left out of the sound bank");
+            continue;
+        }
+
+        SoundBankEntry entry{};
+        std::memcpy(entry.name, source.name.c_str(), source.name.size());
+        entry.sampleCount = samples.size();
+        entry.sampleRate = sampleRate;
+        entry.channelCount = channelCount;
+        entries.push_back(entry);
+        payloads.push_back(std::move(samples));
+    }
+
+    if (entries.empty()) {
+        GAME_LOG_ERROR("No sounds to write to sound bank: " << path);
+        return false;
+    }
+
+    // The bank being replaced may still be mapped, so write beside it and swap the finished file in
+    const std::string tempPath = path + ".tmp";
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        GAME_LOG_ERROR("Failed to create sound bank: " << tempPath);
+        return false;
+    }
+
+    SoundBankHeader header{};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.entryCount = static_cast<std::uint32_t>(entries.size());
+    header.sourceHash = hashSources(sources);
+
+    std::uint64_t offset = alignUp(sizeof(SoundBankHeader) + entries.size() * sizeof(SoundBankEntry));
+    for (SoundBankEntry& entry : entries) {
+        entry.offset = offset;
+        offset = alignUp(offset + entry.sampleCount * sizeof(std::int16_t));
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(SoundBankEntry));
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        file.seekp(static_cast<std::streamoff>(entries[i].offset));
+        file.write(reinterpret_cast<const char*>(payloads[i].data()), payloads[i].size() * sizeof(std::int16_t));
+    }
+
+    file.close();
+    std::error_code ec;
+    if (!file) {
+        GAME_LOG_ERROR("Failed to write sound bank: " << tempPath);
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        GAME_LOG_ERROR("Failed to replace sound bank " << path << ": " << ec.message());
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    GAME_LOG_INFO("Sound bank saved: " << path << " (" << entries.size() << " sounds, " << offset << " bytes)");
+    return true;
+}
+
+} // namespace game::audio
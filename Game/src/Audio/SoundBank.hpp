@@ -0,0 +1,76 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace game::audio {
+
+// On-disk sound bank layout (little-endian):
+//   SoundBankHeader
+//   SoundBankEntry[entryCount]
+//   sample data                  interleaved 16-bit PCM, one run per entry, 16-byte aligned
+struct SoundBankHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t entryCount;
+    std::uint32_t sourceHash;    // Of the SoundBankSource list the bank was built from
+};
+
+struct SoundBankEntry {
+    char name[40];               // Null-terminated
+    std::uint64_t offset;        // From the start of the file
+    std::uint64_t sampleCount;   // Interleaved samples, not frames
+    std::uint32_t sampleRate;
+    std::uint32_t channelCount;  // 1 or 2
+};
+
+static_assert(sizeof(SoundBankHeader) == 16, "SoundBankHeader layout is part of the file format");
+static_assert(sizeof(SoundBankEntry) == 64, "SoundBankEntry layout is part of the file format");
+
+// One effect to pack into a bank
+struct SoundBankSource {
+    std::string name;
+    std::string path;               // Anything sf::InputSoundFile can read
+    unsigned int sampleRate = 0;    // Resample down to this rate; 0 keeps the file's rate
+    bool mono = false;              // Average the channels into one
+};
+
+// Read-only view of a sound bank: every short effect in one file, memory-mapped so
+// opening it is a single read of one contiguous blob.
+class SoundBank {
+public:
+    static constexpr std::uint32_t Version = 1;
+
+    SoundBank() = default;
+    ~SoundBank();
+
+    SoundBank(const SoundBank&) = delete;
+    SoundBank& operator=(const SoundBank&) = delete;
+
+    // Fails on anything malformed, including entries with an unterminated name or a format
+    // sf::SoundBuffer can't load (no samples, not mono/stereo, zero rate)
+    bool open(const std::string& path);
+    void close();
+
+    std::size_t getEntryCount() const { return m_entryCount; }
+    const SoundBankEntry& getEntry(std::size_t index) const { return m_entries[index]; }
+    const SoundBankEntry* find(const std::string& name) const;
+
+    // Points into the mapping; valid until close()
+    const std::int16_t* getSamples(const SoundBankEntry& entry) const;
+
+    // True if `path` was built from exactly `sources` (names, paths and conversions) and none
+    // of their files has been modified since
+    static bool isUpToDate(const std::string& path, const std::vector<SoundBankSource>& sources);
+    // Decodes, converts and packs `sources`; sources that fail to load are skipped
+    static bool write(const std::string& path, const std::vector<SoundBankSource>& sources);
+
+private:
+    const std::uint8_t* m_data = nullptr;
+    std::size_t m_size = 0;
+
+    const SoundBankEntry* m_entries = nullptr;
+    std::size_t m_entryCount = 0;
+};
+
+} // namespace game::audio
@@ -1,208 +1,374 @@
 #include "SoundManager.hpp"
-#include <iostream>
+#include "SoundBank.hpp"
+#include "../core/Profiler.hpp"
+#include "../core/Log.hpp"
 #include <algorithm>
 
 namespace game::audio {
 
-SoundManager::SoundManager()
-    : m_currentMusic(Music::MainTheme)
+const char* getSoundEffectName(SoundEffect effect)
 {
+    switch (effect) {
+        case SoundEffect::PlayerWalk:   return "walk";
+        case SoundEffect::PlayerAttack: return "sword_attack";
+        case SoundEffect::PlayerHit:    return "hit";
+        case SoundEffect::EnemyHit:     return "enemy_hit";
+        case SoundEffect::EnemyDeath:   return "enemy_death";
+        case SoundEffect::GameOver:     return "game_over";
+    }
+    return "";
+}
+
+SoundManager::SoundManager(game::assets::AssetManager& assets)
+    : m_assets(assets)
+{
+    m_voices.reserve(VoiceCount);
+    for (std::size_t i = 0; i < VoiceCount; ++i) {
+        m_voices.emplace_back(m_silence);
+    }
+
+    setEffectLimits(SoundEffect::PlayerWalk,   1, SoundPriority::Low);
+    setEffectLimits(SoundEffect::PlayerAttack, 2, SoundPriority::Normal);
+    setEffectLimits(SoundEffect::PlayerHit,    2, SoundPriority::High);
+    setEffectLimits(SoundEffect::EnemyHit,     4, SoundPriority::Normal);
+    setEffectLimits(SoundEffect::EnemyDeath,   4, SoundPriority::Normal);
+    setEffectLimits(SoundEffect::GameOver,     1, SoundPriority::Critical);
+
+    m_busIds[static_cast<std::size_t>(Bus::Master)] = BusGraph::Root;
+    for (Bus bus : {Bus::Music, Bus::Sfx, Bus::Ui, Bus::Ambient}) {
+        m_busIds[static_cast<std::size_t>(bus)] = m_buses.addBus(BusGraph::Root);
+    }
+    m_buses.setGain(m_busIds[static_cast<std::size_t>(Bus::Music)], 0.5f);
+
+    for (std::size_t i = 0; i < SoundEffectCount; ++i) {
+        m_effectBuses[i] = m_buses.addBus(m_busIds[static_cast<std::size_t>(Bus::Sfx)]);
+    }
+    setEffectBus(SoundEffect::GameOver, Bus::Ui);
+    m_buses.flush();
 }
 
 bool SoundManager::loadSound(SoundEffect effect, const std::string& filepath)
 {
-    sf::SoundBuffer buffer;
-    if (!buffer.loadFromFile(filepath)) {  // SoundBuffer uses loadFromFile
-        std::cerr << "Failed to load sound: " << filepath << "\n";
-        return false;
+    m_soundBuffers[effect] = m_assets.loadSoundBuffer(filepath);
+    return !m_soundBuffers[effect].isFailed();
+}
+
+bool SoundManager::loadSoundBank(const std::string& filepath)
+{
+    GAME_PROFILE_ZONE("SoundManager::loadSoundBank");
+    SoundBank bank;
+    if (!bank.open(filepath)) return false;
+
+    // Buffers copy their samples, so the bank is unmapped again on return
+    std::size_t loaded = 0;
+    std::uint64_t bytes = 0;
+    for (std::size_t i = 0; i < SoundEffectCount; ++i) {
+        auto effect = static_cast<SoundEffect>(i);
+        const SoundBankEntry* entry = bank.find(getSoundEffectName(effect));
+        const std::int16_t* samples = entry ? bank.getSamples(*entry) : nullptr;
+        if (!samples) continue;
+
+        auto buffer = m_assets.addSoundBuffer(filepath + ":" + entry->name, samples, entry->sampleCount,
+                                              entry->channelCount, entry->sampleRate);
+        // A buffer that failed to build is left unset so the caller falls back to the loose file
+        if (!buffer.isReady()) continue;
+
+        m_soundBuffers[effect] = buffer;
+        ++loaded;
+        bytes += entry->sampleCount * sizeof(std::int16_t);
     }
-    
-    m_soundBuffers[effect] = std::move(buffer);
-    std::cout << "Loaded sound: " << filepath << "\n";
+
+    GAME_LOG_INFO("Sound bank loaded: " << filepath << " (" << loaded << " sounds, " << bytes / 1024 << " KB of samples)");
     return true;
 }
 
 bool SoundManager::loadMusic(Music music, const std::string& filepath)
 {
-    auto musicPtr = std::make_unique<sf::Music>();
-    if (!musicPtr->openFromFile(filepath)) {  // Music uses openFromFile
-        std::cerr << "Failed to load music: " << filepath << "\n";
-        return false;
-    }
-    
-    m_music[music] = std::move(musicPtr);
-    std::cout << "Loaded music: " << filepath << "\n";
-    return true;
+    return m_musicEngine.setTrack(static_cast<TrackId>(music), filepath);
 }
 
-void SoundManager::playSound(SoundEffect effect, float volume)
+const sf::SoundBuffer* SoundManager::findBuffer(SoundEffect effect) const
 {
     auto it = m_soundBuffers.find(effect);
-    if (it == m_soundBuffers.end()) {
-        std::cerr << "Sound effect not loaded\n";
-        return;
+    if (it == m_soundBuffers.end() || it->second.isFailed()) {
+        GAME_LOG_WARN("Sound effect not loaded");
+        return nullptr;
     }
-    
-    // SFML 3: Create sound with buffer in constructor
-    auto sound = std::make_unique<sf::Sound>(it->second);
-    sound->setVolume(getEffectiveVolume(volume, false));
-    sound->play();
-    
-    m_activeSounds.push_back(std::move(sound));
+    return it->second.get();   // nullptr while still loading
 }
 
-void SoundManager::playMusic(Music music, bool loop, float volume)
+void SoundManager::setEffectLimits(SoundEffect effect, unsigned int maxVoices, SoundPriority priority)
 {
-    auto it = m_music.find(music);
-    if (it == m_music.end()) {
-        std::cerr << "Music not loaded\n";
-        return;
-    }
-    
-    // Stop current music if playing
-    stopMusic();
-    
-    m_currentMusic = music;
-    it->second->setLooping(loop);  // SFML 3: setLooping instead of setLoop
-    it->second->setVolume(getEffectiveVolume(volume, true));
-    it->second->play();
-    
-    std::cout << "Playing music (loop: " << loop << ")\n";
+    m_limits[static_cast<std::size_t>(effect)] = {maxVoices, priority};
 }
 
-void SoundManager::stopMusic()
+std::size_t SoundManager::getActiveVoiceCount() const
 {
-    for (auto& [music, musicPtr] : m_music) {
-        if (musicPtr && musicPtr->getStatus() == sf::Sound::Status::Playing) {
-            musicPtr->stop();
-        }
-    }
+    return static_cast<std::size_t>(std::count_if(m_voices.begin(), m_voices.end(),
+                                                  [](const Voice& voice) { return voice.active; }));
 }
 
-void SoundManager::pauseMusic()
+SoundManager::Voice* SoundManager::acquireVoice(SoundEffect effect, const sf::SoundBuffer& buffer)
 {
-    for (auto& [music, musicPtr] : m_music) {
-        if (musicPtr && musicPtr->getStatus() == sf::Sound::Status::Playing) {
-            musicPtr->pause();
+    const EffectLimits& limits = m_limits[static_cast<std::size_t>(effect)];
+
+    Voice* freeVoice = nullptr;
+    Voice* oldestSame = nullptr;
+    Voice* victim = nullptr;
+    unsigned int sameCount = 0;
+
+    for (Voice& voice : m_voices) {
+        if (!voice.active) {
+            if (!freeVoice || (&freeVoice->sound.getBuffer() != &buffer && &voice.sound.getBuffer() == &buffer)) {
+                freeVoice = &voice;
+            }
+            continue;
+        }
+
+        if (voice.effect == effect && !voice.looping) {
+            ++sameCount;
+            if (!oldestSame || voice.startedAt < oldestSame->startedAt) oldestSame = &voice;
+        }
+
+        // Only steal from equal or lower priority, and leave sustained loops to strictly higher priorities
+        if (voice.priority > limits.priority || (voice.looping && voice.priority == limits.priority)) continue;
+
+        // Lowest priority first, then the quietest, then the oldest
+        if (!victim || voice.priority < victim->priority ||
+            (voice.priority == victim->priority &&
+             (voice.localVolume < victim->localVolume ||
+              (voice.localVolume == victim->localVolume && voice.startedAt < victim->startedAt)))) {
+            victim = &voice;
         }
     }
+
+    // Over the per-effect limit: retrigger the oldest copy rather than stacking another
+    if (sameCount >= limits.maxVoices) return oldestSame;
+    if (freeVoice) return freeVoice;
+    return victim;
 }
 
-void SoundManager::resumeMusic()
+void SoundManager::setEffectBus(SoundEffect effect, Bus bus)
 {
-    auto it = m_music.find(m_currentMusic);
-    if (it != m_music.end() && it->second) {
-        if (it->second->getStatus() == sf::Sound::Status::Paused) {
-            it->second->play();
-        }
-    }
+    m_buses.setParent(m_effectBuses[static_cast<std::size_t>(effect)], m_busIds[static_cast<std::size_t>(bus)]);
 }
 
-void SoundManager::setMasterVolume(float volume)
+void SoundManager::setBusVolume(Bus bus, float volume)
 {
-    m_masterVolume = std::clamp(volume, 0.f, 100.f);
-    
-    // Update all active sounds
-    for (auto& sound : m_activeSounds) {
-        if (sound) {
-            sound->setVolume(getEffectiveVolume(m_soundVolume, false));
+    m_buses.setGain(m_busIds[static_cast<std::size_t>(bus)], std::clamp(volume, 0.f, 100.f) / 100.f);
+}
+
+float SoundManager::getBusVolume(Bus bus) const
+{
+    return m_buses.getGain(m_busIds[static_cast<std::size_t>(bus)]) * 100.f;
+}
+
+void SoundManager::setEffectVolume(SoundEffect effect, float volume)
+{
+    m_buses.setGain(m_effectBuses[static_cast<std::size_t>(effect)], std::clamp(volume, 0.f, 100.f) / 100.f);
+}
+
+float SoundManager::getVoiceVolume(SoundEffect effect, float localVolume) const
+{
+    return localVolume * m_buses.getEffectiveGain(m_effectBuses[static_cast<std::size_t>(effect)]);
+}
+
+float SoundManager::getMusicVolume() const
+{
+    return m_musicLocalVolume * m_buses.getEffectiveGain(m_busIds[static_cast<std::size_t>(Bus::Music)]);
+}
+
+void SoundManager::applyBusGains()
+{
+    // Only voices whose bus actually changed are touched, and only once per frame
+    for (Voice& voice : m_voices) {
+        if (voice.active && m_buses.hasChanged(m_effectBuses[static_cast<std::size_t>(voice.effect)])) {
+            voice.sound.setVolume(getVoiceVolume(voice.effect, voice.localVolume));
         }
     }
-    
-    // Update music
-    for (auto& [music, musicPtr] : m_music) {
-        if (musicPtr) {
-            musicPtr->setVolume(getEffectiveVolume(m_musicVolume, true));
-        }
+
+    if (m_buses.hasChanged(m_busIds[static_cast<std::size_t>(Bus::Music)])) {
+        m_musicEngine.setVolume(getMusicVolume());
     }
 }
 
-void SoundManager::setSoundVolume(float volume)
+bool SoundManager::isAudible(const sf::Vector2f& position) const
 {
-    m_soundVolume = std::clamp(volume, 0.f, 100.f);
-    
-    for (auto& sound : m_activeSounds) {
-        if (sound) {
-            sound->setVolume(getEffectiveVolume(m_soundVolume, false));
-        }
+    sf::Vector2f offset = position - m_listenerPosition;
+    return offset.x * offset.x + offset.y * offset.y <= m_audibleRadius * m_audibleRadius;
+}
+
+SoundManager::Voice* SoundManager::startVoice(SoundEffect effect, float volume, bool loop, const sf::Vector2f* position)
+{
+    if (position && !isAudible(*position)) {
+        ++m_culledCount;
+        return nullptr;
+    }
+
+    const sf::SoundBuffer* buffer = findBuffer(effect);
+    if (!buffer) return nullptr;
+
+    Voice* voice = acquireVoice(effect, *buffer);
+    if (!voice) return nullptr;
+
+    voice->sound.stop();
+    // Rebinding re-creates the underlying sound (and allocates), so retriggers and steals
+    // of the same effect keep their binding
+    if (&voice->sound.getBuffer() != buffer) {
+        voice->sound.setBuffer(*buffer);
     }
+    voice->sound.setLooping(loop);
+    voice->sound.setVolume(getVoiceVolume(effect, volume));
+    if (position) {
+        // World x/y map onto the listener's x/y plane
+        voice->sound.setRelativeToListener(false);
+        voice->sound.setPosition({position->x, position->y, 0.f});
+        voice->sound.setMinDistance(m_minDistance);
+        voice->sound.setAttenuation(m_attenuation);
+    } else {
+        voice->sound.setRelativeToListener(true);
+        voice->sound.setPosition({0.f, 0.f, 0.f});
+    }
+    voice->sound.play();
+
+    voice->effect = effect;
+    voice->priority = m_limits[static_cast<std::size_t>(effect)].priority;
+    voice->localVolume = volume;
+    voice->startedAt = ++m_triggerCounter;
+    voice->active = true;
+    voice->looping = loop;
+    voice->positional = position != nullptr;
+    return voice;
+}
+
+void SoundManager::releaseVoice(Voice& voice)
+{
+    voice.sound.stop();
+    voice.active = false;
+    voice.looping = false;
+}
+
+void SoundManager::playSound(SoundEffect effect, float volume)
+{
+    startVoice(effect, volume, false, nullptr);
+}
+
+void SoundManager::playSound(SoundEffect effect, const sf::Vector2f& position, float volume)
+{
+    startVoice(effect, volume, false, &position);
 }
 
-void SoundManager::setMusicVolume(float volume)
+void SoundManager::setListenerPosition(const sf::Vector2f& position)
+{
+    m_listenerPosition = position;
+    sf::Listener::setPosition({position.x, position.y, 0.f});
+}
+
+void SoundManager::playMusic(Music music, bool loop, float volume)
 {
-    m_musicVolume = std::clamp(volume, 0.f, 100.f);
+    m_musicLocalVolume = volume;
+    m_musicEngine.setVolume(getMusicVolume());
+    m_musicEngine.play(static_cast<TrackId>(music), loop);
     
-    for (auto& [music, musicPtr] : m_music) {
-        if (musicPtr) {
-            musicPtr->setVolume(getEffectiveVolume(m_musicVolume, true));
-        }
-    }
+    GAME_LOG_DEBUG("Playing music (loop: " << loop << ")");
+}
+
+void SoundManager::crossfadeMusic(Music music, sf::Time duration, bool loop)
+{
+    m_musicEngine.crossfadeTo(static_cast<TrackId>(music), duration, loop);
+}
+
+void SoundManager::prefetchMusic(Music music)
+{
+    m_musicEngine.prefetch(static_cast<TrackId>(music));
+}
+
+void SoundManager::stopMusic()
+{
+    m_musicEngine.stop();
+}
+
+void SoundManager::pauseMusic()
+{
+    m_musicEngine.pause();
+}
+
+void SoundManager::resumeMusic()
+{
+    m_musicEngine.resume();
 }
 
 void SoundManager::stopAllSounds()
 {
-    for (auto& sound : m_activeSounds) {
-        if (sound) {
-            sound->stop();
+    for (Voice& voice : m_voices) {
+        if (voice.active && !voice.looping) {
+            releaseVoice(voice);
         }
     }
-    m_activeSounds.clear();
 }
 
 void SoundManager::update()
 {
-    // Remove finished sounds
-    m_activeSounds.erase(
-        std::remove_if(m_activeSounds.begin(), m_activeSounds.end(),
-            [](const auto& sound) {
-                return !sound || sound->getStatus() == sf::Sound::Status::Stopped;
-            }),
-        m_activeSounds.end()
-    );
-}
+    GAME_PROFILE_ZONE("SoundManager::update");
+    
+    // Free voices whose one-shot has finished
+    for (Voice& voice : m_voices) {
+        if (voice.active && !voice.looping && voice.sound.getStatus() == sf::Sound::Status::Stopped) {
+            voice.active = false;
+        }
+    }
 
-float SoundManager::getEffectiveVolume(float localVolume, bool isMusic) const
-{
-    float baseVolume = isMusic ? m_musicVolume : m_soundVolume;
-    return (baseVolume / 100.f) * (m_masterVolume / 100.f) * localVolume;
+    if (m_buses.flush()) {
+        applyBusGains();
+    }
+
+    m_musicEngine.update();
 }
 
 void SoundManager::playLoopingSound(SoundEffect effect, float volume)
 {
     // Already playing? Don't restart it
-    auto existing = m_loopingSounds.find(effect);
-    if (existing != m_loopingSounds.end() &&
-        existing->second->getStatus() == sf::Sound::Status::Playing) {
-        return;
+    for (const Voice& voice : m_voices) {
+        if (voice.active && voice.looping && voice.effect == effect) return;
     }
 
-    auto it = m_soundBuffers.find(effect);
-    if (it == m_soundBuffers.end()) {
-        std::cerr << "Sound effect not loaded\n";
-        return;
+    startVoice(effect, volume, true, nullptr);
+}
+
+void SoundManager::playLoopingSound(SoundEffect effect, const sf::Vector2f& position, float volume)
+{
+    for (const Voice& voice : m_voices) {
+        if (voice.active && voice.looping && voice.effect == effect) return;
     }
 
-    auto sound = std::make_unique<sf::Sound>(it->second);
-    sound->setLooping(true);
-    sound->setVolume(getEffectiveVolume(volume, false));
-    sound->play();
-    m_loopingSounds[effect] = std::move(sound);
+    startVoice(effect, volume, true, &position);
+}
+
+void SoundManager::setLoopingSoundPosition(SoundEffect effect, const sf::Vector2f& position)
+{
+    for (Voice& voice : m_voices) {
+        if (voice.active && voice.looping && voice.positional && voice.effect == effect) {
+            voice.sound.setPosition({position.x, position.y, 0.f});
+        }
+    }
 }
 
 void SoundManager::stopLoopingSound(SoundEffect effect)
 {
-    auto it = m_loopingSounds.find(effect);
-    if (it != m_loopingSounds.end()) {
-        it->second->stop();
-        m_loopingSounds.erase(it);
+    for (Voice& voice : m_voices) {
+        if (voice.active && voice.looping && voice.effect == effect) {
+            releaseVoice(voice);
+        }
     }
 }
 
 void SoundManager::stopAllLoopingSounds()
 {
-    for (auto& [effect, sound] : m_loopingSounds)
-        if (sound) sound->stop();
-    m_loopingSounds.clear();
+    for (Voice& voice : m_voices) {
+        if (voice.active && voice.looping) {
+            releaseVoice(voice);
+        }
+    }
 }
 
 } // namespace game::audio
\ No newline at end of file
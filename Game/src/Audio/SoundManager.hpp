@@ -1,8 +1,12 @@
 #pragma once
 #include <SFML/Audio.hpp>
+#include <array>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
-#include <memory>
+#include "../assets/AssetManager.hpp"
+#include "BusGraph.hpp"
+#include "MusicEngine.hpp"
 
 namespace game::audio {
 
@@ -15,6 +19,30 @@ enum class SoundEffect {
     GameOver
 };
 
+constexpr std::size_t SoundEffectCount = static_cast<std::size_t>(SoundEffect::GameOver) + 1;
+
+// Name an effect is stored under in a sound bank
+const char* getSoundEffectName(SoundEffect effect);
+
+// Decides who wins when every voice is busy: a sound can only take a voice from one of equal or lower priority
+enum class SoundPriority : std::uint8_t {
+    Low,
+    Normal,
+    High,
+    Critical
+};
+
+// Mixer buses under Master; every sound effect also gets its own bus beneath its category
+enum class Bus : std::uint8_t {
+    Master,
+    Music,
+    Sfx,
+    Ui,
+    Ambient
+};
+
+constexpr std::size_t BusCount = static_cast<std::size_t>(Bus::Ambient) + 1;
+
 enum class Music {
     MainTheme,
     BattleTheme
@@ -22,28 +50,65 @@ enum class Music {
 
 class SoundManager {
 public:
-    SoundManager();
+    explicit SoundManager(game::assets::AssetManager& assets);
     
-    // Load sounds
+    // Queue files for loading through the asset manager; false if the file is already known to be bad.
+    // Effects that are still loading are skipped when played.
     bool loadSound(SoundEffect effect, const std::string& filepath);
+    // Load every effect found in a sound bank (see SoundBank) in one go; false if the bank can't be opened.
+    // Effects missing from the bank are left as they were; check hasSound() and load them individually.
+    bool loadSoundBank(const std::string& filepath);
+    // True once `effect` has been loaded or queued for loading from any source
+    bool hasSound(SoundEffect effect) const { return m_soundBuffers.count(effect) != 0; }
+    // Music is only registered here; the file stays closed until the track is prefetched or played
     bool loadMusic(Music music, const std::string& filepath);
     
-    // Play sounds
+    // Play sounds. Without a position they play at the listener (UI, the player's own sounds).
     void playSound(SoundEffect effect, float volume = 100.f);
     void playMusic(Music music, bool loop = true, float volume = 50.f);
+
+    // Play at a world position. Anything beyond the audible radius from the listener is
+    // dropped before a voice is taken, so far-off sources cost nothing.
+    void playSound(SoundEffect effect, const sf::Vector2f& position, float volume = 100.f);
+    void playLoopingSound(SoundEffect effect, const sf::Vector2f& position, float volume = 100.f);
+    void setLoopingSoundPosition(SoundEffect effect, const sf::Vector2f& position);
+
+    // Listener placement in world units; follow the camera centre every frame
+    void setListenerPosition(const sf::Vector2f& position);
+    void setAudibleRadius(float radius) { m_audibleRadius = radius; }
+    float getAudibleRadius() const { return m_audibleRadius; }
+    std::size_t getCulledCount() const { return m_culledCount; }   // Positional triggers dropped so far
+    
+    // Fade from the current track to `music` over exactly `duration`
+    void crossfadeMusic(Music music, sf::Time duration = sf::seconds(2.f), bool loop = true);
+    // Open `music` and buffer its start in the background so a later play/crossfade begins instantly
+    void prefetchMusic(Music music);
     
     // Control
     void stopMusic();
     void pauseMusic();
     void resumeMusic();
     
-    void setMasterVolume(float volume); // 0-100
-    void setSoundVolume(float volume);  // 0-100
-    void setMusicVolume(float volume);  // 0-100
+    // Volumes are 0-100. Changes are cheap: they only mark the bus, and the next update()
+    // pushes the new levels to the sounds playing on it.
+    void setBusVolume(Bus bus, float volume);
+    float getBusVolume(Bus bus) const;
+    void setEffectVolume(SoundEffect effect, float volume);
+    void setMasterVolume(float volume) { setBusVolume(Bus::Master, volume); }
+    void setSoundVolume(float volume) { setBusVolume(Bus::Sfx, volume); }
+    void setMusicVolume(float volume) { setBusVolume(Bus::Music, volume); }
     
     void stopAllSounds();
+
+    // At most `maxVoices` copies of `effect` play at once; a further trigger restarts the oldest one
+    void setEffectLimits(SoundEffect effect, unsigned int maxVoices, SoundPriority priority);
+    // Which category bus `effect` mixes into (Sfx unless changed)
+    void setEffectBus(SoundEffect effect, Bus bus);
+
+    std::size_t getActiveVoiceCount() const;
+    std::size_t getVoiceCount() const { return m_voices.size(); }
     
-    // Update (call every frame to manage sound instances)
+    // Update (call every frame to manage sound instances, apply volume changes and start music that finished loading)
     void update();
 
     void playLoopingSound(SoundEffect effect, float volume = 100.f);
@@ -51,26 +116,67 @@ public:
     void stopAllLoopingSounds();
     
 private:
-    // Sound buffers (must persist)
-    std::unordered_map<SoundEffect, sf::SoundBuffer> m_soundBuffers;
+    game::assets::AssetManager& m_assets;
+
+    // Sound buffers (shared with the asset cache, so they outlive every sound using them)
+    std::unordered_map<SoundEffect, game::assets::SoundBufferHandle> m_soundBuffers;
     
-    // Sound instances (multiple can play at once)
-    std::vector<std::unique_ptr<sf::Sound>> m_activeSounds;
+    // Fixed set of voices shared by one-shot and looping effects. Voices are created once and
+    // keep their buffer binding between triggers; only a voice switching to a different
+    // effect's buffer is rebound (which allocates inside SFML).
+    static constexpr std::size_t VoiceCount = 32;
+
+    struct Voice {
+        explicit Voice(const sf::SoundBuffer& buffer) : sound(buffer) {}
+
+        sf::Sound sound;
+        SoundEffect effect = SoundEffect::PlayerWalk;
+        SoundPriority priority = SoundPriority::Normal;
+        float localVolume = 100.f;
+        std::uint64_t startedAt = 0;   // Trigger counter, for picking the oldest voice
+        bool active = false;
+        bool looping = false;
+        bool positional = false;
+    };
+
+    struct EffectLimits {
+        unsigned int maxVoices = 4;
+        SoundPriority priority = SoundPriority::Normal;
+    };
+
+    // Voice to play `effect` on, or nullptr if every voice is busy with something more important.
+    // Free voices already bound to `buffer` are preferred so they don't need rebinding.
+    Voice* acquireVoice(SoundEffect effect, const sf::SoundBuffer& buffer);
+    // `position` is null for sounds that play at the listener
+    Voice* startVoice(SoundEffect effect, float volume, bool loop, const sf::Vector2f* position);
+    bool isAudible(const sf::Vector2f& position) const;
+    void releaseVoice(Voice& voice);
+
+    sf::SoundBuffer m_silence;        // Placeholder buffer idle voices are bound to
+    std::vector<Voice> m_voices;
+    std::array<EffectLimits, SoundEffectCount> m_limits;
+    std::uint64_t m_triggerCounter = 0;
+
+    // Positional audio, in world units (pixels)
+    sf::Vector2f m_listenerPosition;
+    float m_audibleRadius = 700.f;     // A little beyond the corners of the view
+    float m_minDistance = 150.f;       // Full volume inside this distance
+    float m_attenuation = 1.f;         // How fast volume falls off past m_minDistance
+    std::size_t m_culledCount = 0;
     
-    // Music (only one plays at a time)
-    std::unordered_map<Music, std::unique_ptr<sf::Music>> m_music;
-    Music m_currentMusic;
+    // Music (one track, or two while crossfading)
+    MusicEngine m_musicEngine;
+    float m_musicLocalVolume = 50.f;
     
-    // Volume settings
-    float m_masterVolume = 100.f;
-    float m_soundVolume = 100.f;
-    float m_musicVolume = 50.f;
+    // Mixer buses. A voice's volume is its own level times its effect bus's effective gain.
+    BusGraph m_buses;
+    std::array<BusGraph::BusId, BusCount> m_busIds;
+    std::array<BusGraph::BusId, SoundEffectCount> m_effectBuses;
     
-    float getEffectiveVolume(float localVolume, bool isMusic) const;
-
-    // Looping sound channels (for sustained effects like footsteps)
-    std::unordered_map<SoundEffect, std::unique_ptr<sf::Sound>> m_loopingSounds;
-
+    float getVoiceVolume(SoundEffect effect, float localVolume) const;
+    float getMusicVolume() const;
+    void applyBusGains();
+    const sf::SoundBuffer* findBuffer(SoundEffect effect) const;
 };
 
 } // namespace game::audio
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include "VoiceCapture.hpp"
+#include "../core/Log.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+namespace game::audio {
+
+// Microphone input; SFML calls onProcessSamples on its capture thread as each device period arrives
+class VoiceCapture::DeviceRecorder : public sf::SoundRecorder {
+public:
+    explicit DeviceRecorder(VoiceCapture& owner) : m_owner(owner) {}
+    ~DeviceRecorder() override { stop(); }
+
+protected:
+    bool onProcessSamples(const std::int16_t* samples, std::size_t sampleCount) override
+    {
+        m_owner.write(samples, sampleCount);
+        return true;
+    }
+
+private:
+    VoiceCapture& m_owner;
+};
+
+VoiceCapture::VoiceCapture() = default;
+
+VoiceCapture::~VoiceCapture()
+{
+    stop();
+}
+
+std::int64_t VoiceCapture::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool VoiceCapture::startDevice(const std::string& device, unsigned int sampleRate)
+{
+    stop();
+    if (!sf::SoundRecorder::isAvailable()) {
+        GAME_LOG_ERROR("Audio capture is not available on this system");
+        return false;
+    }
+
+    m_recorder = std::make_unique<DeviceRecorder>(*this);
+    if (!device.empty() && !m_recorder->setDevice(device)) {
+        GAME_LOG_ERROR("Failed to select capture device: " << device);
+        m_recorder.reset();
+        return false;
+    }
+
+    m_sampleRate = sampleRate;
+    m_frameSamples = std::min<std::size_t>(sampleRate / 100, VoiceFrame::MaxSamples);
+    m_pending.sampleCount = 0;
+
+    m_recorder->setChannelCount(1);
+    if (!m_recorder->start(sampleRate)) {
+        GAME_LOG_ERROR("Failed to start audio capture");
+        m_recorder.reset();
+        return false;
+    }
+
+    m_capturing = true;
+    GAME_LOG_INFO("Voice capture started (" << sampleRate << " Hz)");
+    return true;
+}
+
+bool VoiceCapture::startFile(const std::string& path, bool loop)
+{
+    stop();
+    if (!m_file.openFromFile(path) || m_file.getChannelCount() == 0) {
+        GAME_LOG_ERROR("Failed to open voice test file: " << path);
+        return false;
+    }
+
+    m_sampleRate = m_file.getSampleRate();
+    m_frameSamples = std::min<std::size_t>(m_sampleRate / 100, VoiceFrame::MaxSamples);
+    m_pending.sampleCount = 0;
+
+    m_fileRunning = true;
+    m_fileThread = std::thread(&VoiceCapture::fileLoop, this, loop);
+    m_capturing = true;
+    GAME_LOG_INFO("Voice capture from file: " << path << " (" << m_sampleRate << " Hz)");
+    return true;
+}
+
+void VoiceCapture::stop()
+{
+    if (m_recorder) {
+        m_recorder->stop();
+        m_recorder.reset();
+    }
+    if (m_fileThread.joinable()) {
+        m_fileRunning = false;
+        m_fileThread.join();
+        m_file.close();
+    }
+    m_capturing = false;
+}
+
+void VoiceCapture::write(const std::int16_t* samples, std::size_t count)
+{
+    if (!m_transmitting.load(std::memory_order_relaxed)) {
+        // Start every transmission on a fresh frame
+        m_pending.sampleCount = 0;
+        return;
+    }
+
+    while (count > 0) {
+        std::size_t take = std::min(count, m_frameSamples - m_pending.sampleCount);
+        std::memcpy(m_pending.samples.data() + m_pending.sampleCount, samples, take * sizeof(std::int16_t));
+        m_pending.sampleCount += static_cast<std::uint32_t>(take);
+        samples += take;
+        count -= take;
+
+        if (m_pending.sampleCount == m_frameSamples) {
+            m_pending.capturedAt = now();
+            if (!m_queue.push(m_pending)) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+            m_pending.sampleCount = 0;
+        }
+    }
+}
+
+void VoiceCapture::fileLoop(bool loop)
+{
+    // Deliver one frame every 10 ms, like a device would
+    const unsigned int channels = m_file.getChannelCount();
+    std::vector<std::int16_t> interleaved(m_frameSamples * channels);
+    std::array<std::int16_t, VoiceFrame::MaxSamples> mono{};
+    const auto period = std::chrono::microseconds(10000);
+    auto deadline = std::chrono::steady_clock::now();
+
+    while (m_fileRunning) {
+        std::size_t frames = static_cast<std::size_t>(m_file.read(interleaved.data(), interleaved.size()) / channels);
+        if (frames == 0) {
+            if (!loop || m_file.getSampleCount() == 0) break;
+            m_file.seek(std::uint64_t{0});
+            continue;
+        }
+
+        for (std::size_t i = 0; i < frames; ++i) {
+            int sum = 0;
+            for (unsigned int c = 0; c < channels; ++c) sum += interleaved[i * channels + c];
+            mono[i] = static_cast<std::int16_t>(sum / static_cast<int>(channels));
+        }
+        write(mono.data(), frames);
+
+        deadline += period;
+        std::this_thread::sleep_until(deadline);
+    }
+}
+
+} // namespace game::audio
@@ -0,0 +1,81 @@
+#pragma once
+#include <SFML/Audio.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include "../core/SpscRing.hpp"
+
+namespace game::audio {
+
+// 10 ms of mono voice. Frames are fixed-size so nothing on the capture path allocates.
+struct VoiceFrame {
+    static constexpr std::size_t MaxSamples = 480;   // 10 ms at 48 kHz
+
+    std::int64_t capturedAt = 0;      // steady_clock nanoseconds when the frame's last sample arrived
+    std::uint32_t sampleCount = 0;
+    std::array<std::int16_t, MaxSamples> samples{};
+};
+
+// Streams microphone input (or a WAV file standing in for it) into a lock-free queue of
+// voice frames. Capture keeps running while push-to-talk is released so pressing the key
+// has no device start-up delay; frames are only queued while transmitting.
+// Exactly one consumer (an encoder, or VoiceLoopback) pops frames.
+class VoiceCapture {
+public:
+    static constexpr unsigned int DefaultSampleRate = 48000;
+    static constexpr std::size_t QueueFrames = 64;    // 640 ms of slack for a stalled consumer
+
+    VoiceCapture();
+    ~VoiceCapture();
+
+    VoiceCapture(const VoiceCapture&) = delete;
+    VoiceCapture& operator=(const VoiceCapture&) = delete;
+
+    // Capture from a device (empty = the default one)
+    bool startDevice(const std::string& device = "", unsigned int sampleRate = DefaultSampleRate);
+    // Feed a WAV file in real time instead of a microphone (tests, no hardware)
+    bool startFile(const std::string& path, bool loop = true);
+    void stop();
+    bool isCapturing() const { return m_capturing; }
+
+    // Push-to-talk
+    void setTransmitting(bool transmitting) { m_transmitting.store(transmitting, std::memory_order_relaxed); }
+    bool isTransmitting() const { return m_transmitting.load(std::memory_order_relaxed); }
+
+    // Consumer side
+    bool pop(VoiceFrame& frame) { return m_queue.pop(frame); }
+    bool discard() { return m_queue.discard(); }
+    std::size_t getQueuedFrames() const { return m_queue.size(); }
+
+    unsigned int getSampleRate() const { return m_sampleRate; }
+    std::uint64_t getDroppedFrames() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    static std::int64_t now();   // Clock used for capturedAt
+
+private:
+    class DeviceRecorder;
+
+    // Producer side: cut incoming mono samples into frames. Called from SFML's capture
+    // thread or the file thread, never both.
+    void write(const std::int16_t* samples, std::size_t count);
+    void fileLoop(bool loop);
+
+    std::unique_ptr<DeviceRecorder> m_recorder;
+    sf::InputSoundFile m_file;
+    std::thread m_fileThread;
+    std::atomic<bool> m_fileRunning{false};
+
+    core::SpscRing<VoiceFrame, QueueFrames> m_queue;
+    VoiceFrame m_pending;                    // Frame being filled by the producer
+    std::size_t m_frameSamples = 0;
+    unsigned int m_sampleRate = DefaultSampleRate;
+    bool m_capturing = false;
+
+    std::atomic<bool> m_transmitting{false};
+    std::atomic<std::uint64_t> m_dropped{0};
+};
+
+} // namespace game::audio
@@ -0,0 +1,73 @@
+#include "VoiceLoopback.hpp"
+#include <algorithm>
+
+namespace game::audio {
+
+VoiceLoopback::VoiceLoopback(VoiceCapture& capture)
+    : m_capture(capture)
+{
+}
+
+VoiceLoopback::~VoiceLoopback()
+{
+    stop();
+}
+
+void VoiceLoopback::start()
+{
+    stop();
+    initialize(1, m_capture.getSampleRate(), {sf::SoundChannel::Mono});
+    resetStats();
+    play();
+}
+
+float VoiceLoopback::getLatencyMs() const
+{
+    return static_cast<float>(m_latency.load(std::memory_order_relaxed)) / 1e6f;
+}
+
+float VoiceLoopback::getMaxLatencyMs() const
+{
+    return static_cast<float>(m_maxLatency.load(std::memory_order_relaxed)) / 1e6f;
+}
+
+void VoiceLoopback::resetStats()
+{
+    m_maxLatency.store(0, std::memory_order_relaxed);
+    m_underruns.store(0, std::memory_order_relaxed);
+}
+
+bool VoiceLoopback::onGetData(Chunk& data)
+{
+    // Catch up rather than letting a stall turn into permanent delay
+    while (m_capture.getQueuedFrames() > MaxBacklogFrames) {
+        m_capture.discard();
+    }
+
+    if (m_capture.pop(m_frame)) {
+        std::int64_t latency = VoiceCapture::now() - m_frame.capturedAt;
+        m_latency.store(latency, std::memory_order_relaxed);
+        if (latency > m_maxLatency.load(std::memory_order_relaxed)) {
+            m_maxLatency.store(latency, std::memory_order_relaxed);
+        }
+
+        data.samples = m_frame.samples.data();
+        data.sampleCount = m_frame.sampleCount;
+        return true;
+    }
+
+    // Nothing queued: keep the stream alive with 10 ms of silence
+    if (m_capture.isTransmitting()) {
+        m_underruns.fetch_add(1, std::memory_order_relaxed);
+    }
+    data.samples = m_silence.data();
+    data.sampleCount = std::min<std::size_t>(getSampleRate() / 100, m_silence.size());
+    return true;
+}
+
+void VoiceLoopback::onSeek(sf::Time)
+{
+    // Live input has nowhere to seek to
+}
+
+} // namespace game::audio
@@ -0,0 +1,43 @@
+#pragma once
+#include <SFML/Audio.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include "VoiceCapture.hpp"
+
+namespace game::audio {
+
+// Consumes voice frames and plays them straight back: the push-to-talk monitor, and the
+// reference consumer for measuring capture-to-playback latency. Each callback hands SFML
+// one 10 ms frame; a backlog beyond a few frames is dropped so delay can't build up.
+class VoiceLoopback : public sf::SoundStream {
+public:
+    static constexpr std::size_t MaxBacklogFrames = 3;
+
+    explicit VoiceLoopback(VoiceCapture& capture);
+    ~VoiceLoopback() override;
+
+    // Match the capture format and start playing; call after the capture has started
+    void start();
+
+    // From a frame's last captured sample to its hand-off to the output, in milliseconds
+    float getLatencyMs() const;
+    float getMaxLatencyMs() const;   // Worst since the last resetStats()
+    std::uint64_t getUnderruns() const { return m_underruns.load(std::memory_order_relaxed); }
+    void resetStats();
+
+protected:
+    bool onGetData(Chunk& data) override;
+    void onSeek(sf::Time timeOffset) override;
+
+private:
+    VoiceCapture& m_capture;
+    VoiceFrame m_frame;                                          // Frame SFML is currently reading
+    std::array<std::int16_t, VoiceFrame::MaxSamples> m_silence{};   // Played while nobody talks
+
+    std::atomic<std::int64_t> m_latency{0};                     // Nanoseconds
+    std::atomic<std::int64_t> m_maxLatency{0};
+    std::atomic<std::uint64_t> m_underruns{0};
+};
+
+} // namespace game::audio
@@ -0,0 +1,171 @@
+#include "AssetManager.hpp"
+#include "../core/Log.hpp"
+#include "../core/Profiler.hpp"
+#include <fstream>
+#include <iterator>
+
+namespace game::assets {
+
+AssetManager::AssetManager(unsigned int workerThreads)
+    : m_pool(workerThreads + 1)   // The pool counts the calling thread, which never runs submitted work
+{
+}
+
+template <typename T>
+AssetHandle<T> AssetManager::request(Cache<T>& cache, const std::string& path,
+                                     std::function<void(const SlotPtr<T>&)> load)
+{
+    auto it = cache.find(path);
+    if (it != cache.end()) {
+        return AssetHandle<T>(it->second);
+    }
+
+    auto slot = std::make_shared<AssetSlot<T>>();
+    slot->path = path;
+    cache.emplace(path, slot);
+    m_pending.fetch_add(1, std::memory_order_relaxed);
+
+    m_pool.submit([slot, load = std::move(load)]() {
+        GAME_PROFILE_ZONE("AssetManager::decode");
+        load(slot);
+    });
+    return AssetHandle<T>(slot);
+}
+
+template <typename T>
+void AssetManager::complete(AssetSlot<T>& slot, bool ok, const char* kind)
+{
+    if (ok) {
+        GAME_LOG_INFO("Loaded " << kind << ": " << slot.path);
+    } else {
+        GAME_LOG_ERROR("Failed to load " << kind << ": " << slot.path);
+    }
+    slot.state.store(ok ? AssetState::Ready : AssetState::Failed, std::memory_order_release);
+    m_pending.fetch_sub(1, std::memory_order_relaxed);
+}
+
+TextureHandle AssetManager::loadTexture(const std::string& path)
+{
+    return request<sf::Texture>(m_textures, path, [this](const SlotPtr<sf::Texture>& slot) {
+        // Decode here, upload on the main thread where the GL context lives
+        auto image = std::make_shared<sf::Image>();
+        if (!image->loadFromFile(slot->path)) {
+            complete(*slot, false, "texture");
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_uploadMutex);
+        m_uploads.push_back([this, slot, image]() {
+            complete(*slot, slot->asset.loadFromImage(*image), "texture");
+        });
+    });
+}
+
+ImageHandle AssetManager::loadImage(const std::string& path)
+{
+    return request<sf::Image>(m_images, path, [this](const SlotPtr<sf::Image>& slot) {
+        complete(*slot, slot->asset.loadFromFile(slot->path), "image");
+    });
+}
+
+FontHandle AssetManager::loadFont(const std::string& path)
+{
+    return request<sf::Font>(m_fonts, path, [this](const SlotPtr<sf::Font>& slot) {
+        // sf::Font keeps reading glyphs from its source, so read the file once and keep the bytes
+        std::ifstream file(slot->path, std::ios::binary);
+        slot->backing.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        bool ok = !slot->backing.empty() && slot->asset.openFromMemory(slot->backing.data(), slot->backing.size());
+        complete(*slot, ok, "font");
+    });
+}
+
+SoundBufferHandle AssetManager::loadSoundBuffer(const std::string& path)
+{
+    return request<sf::SoundBuffer>(m_soundBuffers, path, [this](const SlotPtr<sf::SoundBuffer>& slot) {
+        complete(*slot, slot->asset.loadFromFile(slot->path), "sound");
+    });
+}
+
+MusicHandle AssetManager::loadMusic(const std::string& path)
+{
+    return request<sf::Music>(m_music, path, [this](const SlotPtr<sf::Music>& slot) {
+        complete(*slot, slot->asset.openFromFile(slot->path), "music");
+    });
+}
+
+TextureHandle AssetManager::addTexture(const std::string& key, const sf::Image& image)
+{
+    auto slot = std::make_shared<AssetSlot<sf::Texture>>();
+    slot->path = key;
+    bool ok = slot->asset.loadFromImage(image);
+    if (!ok) {
+        GAME_LOG_ERROR("Failed to create texture: " << key);
+    }
+    slot->state.store(ok ? AssetState::Ready : AssetState::Failed, std::memory_order_release);
+
+    m_textures[key] = slot;
+    return TextureHandle(slot);
+}
+
+SoundBufferHandle AssetManager::addSoundBuffer(const std::string& key, const std::int16_t* samples,
+                                               std::uint64_t sampleCount, unsigned int channelCount,
+                                               unsigned int sampleRate)
+{
+    auto slot = std::make_shared<AssetSlot<sf::SoundBuffer>>();
+    slot->path = key;
+    std::vector<sf::SoundChannel> channelMap;
+    if (channelCount == 1) {
+        channelMap = {sf::SoundChannel::Mono};
+    } else {
+        channelMap = {sf::SoundChannel::FrontLeft, sf::SoundChannel::FrontRight};
+    }
+    bool ok = slot->asset.loadFromSamples(samples, sampleCount, channelCount, sampleRate, channelMap);
+    if (!ok) {
+        GAME_LOG_ERROR("Failed to create sound: " << key);
+    }
+    slot->state.store(ok ? AssetState::Ready : AssetState::Failed, std::memory_order_release);
+
+    m_soundBuffers[key] = slot;
+    return SoundBufferHandle(slot);
+}
+
+void AssetManager::update()
+{
+    std::vector<std::function<void()>> uploads;
+    {
+        std::lock_guard<std::mutex> lock(m_uploadMutex);
+        if (m_uploads.empty()) return;
+        uploads.swap(m_uploads);
+    }
+
+    GAME_PROFILE_ZONE("AssetManager::upload");
+    for (auto& upload : uploads) {
+        upload();
+    }
+}
+
+std::size_t AssetManager::collectUnused()
+{
+    std::size_t dropped = 0;
+    auto collect = [&dropped](auto& cache) {
+        for (auto it = cache.begin(); it != cache.end(); ) {
+            // Only the cache holds it, and no worker is still filling it in
+            if (it->second.use_count() == 1 &&
+                it->second->state.load(std::memory_order_acquire) != AssetState::Loading) {
+                it = cache.erase(it);
+                ++dropped;
+            } else {
+                ++it;
+            }
+        }
+    };
+
+    collect(m_textures);
+    collect(m_images);
+    collect(m_fonts);
+    collect(m_soundBuffers);
+    collect(m_music);
+    return dropped;
+}
+
+} // namespace game::assets
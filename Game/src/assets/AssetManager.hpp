@@ -0,0 +1,134 @@
+#pragma once
+#include <SFML/Audio.hpp>
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "../core/ThreadPool.hpp"
+
+namespace game::assets {
+
+enum class AssetState : std::uint8_t { Loading, Ready, Failed };
+
+// Shared between every handle to one path and the worker decoding it
+template <typename T>
+struct AssetSlot {
+    std::string path;
+    std::atomic<AssetState> state{AssetState::Loading};
+    T asset;                              // Only touched by the loader until state leaves Loading
+    std::vector<std::uint8_t> backing;    // File contents for assets that keep reading from memory (fonts)
+};
+
+// Reference-counted handle to a cached asset. Copies share the asset; it stays
+// alive while any handle (or the cache) refers to it.
+template <typename T>
+class AssetHandle {
+public:
+    AssetHandle() = default;
+
+    bool isValid() const { return m_slot != nullptr; }
+    bool isLoading() const { return m_slot && m_slot->state.load(std::memory_order_acquire) == AssetState::Loading; }
+    bool isReady() const { return m_slot && m_slot->state.load(std::memory_order_acquire) == AssetState::Ready; }
+    bool isFailed() const { return m_slot && m_slot->state.load(std::memory_order_acquire) == AssetState::Failed; }
+
+    // nullptr until the asset is ready
+    T* get() const { return isReady() ? &m_slot->asset : nullptr; }
+    T& operator*() const { return m_slot->asset; }
+    T* operator->() const { return &m_slot->asset; }
+
+    const std::string& getPath() const { return m_slot->path; }
+
+private:
+    friend class AssetManager;
+    explicit AssetHandle(std::shared_ptr<AssetSlot<T>> slot) : m_slot(std::move(slot)) {}
+
+    std::shared_ptr<AssetSlot<T>> m_slot;
+};
+
+using TextureHandle = AssetHandle<sf::Texture>;
+using ImageHandle = AssetHandle<sf::Image>;
+using FontHandle = AssetHandle<sf::Font>;
+using SoundBufferHandle = AssetHandle<sf::SoundBuffer>;
+using MusicHandle = AssetHandle<sf::Music>;   // Streams from disk; every holder shares one player
+
+// Loads game assets once and hands out shared handles, keyed by path.
+// Files are read and decoded on worker threads; textures are then uploaded to the
+// GPU on the main thread in update(). Requesting a path that is cached (or still
+// loading) returns the existing asset, so reloading after a restart costs nothing.
+// All member functions are for the main thread.
+class AssetManager {
+public:
+    explicit AssetManager(unsigned int workerThreads = 2);
+
+    AssetManager(const AssetManager&) = delete;
+    AssetManager& operator=(const AssetManager&) = delete;
+
+    TextureHandle loadTexture(const std::string& path);
+    ImageHandle loadImage(const std::string& path);
+    FontHandle loadFont(const std::string& path);
+    SoundBufferHandle loadSoundBuffer(const std::string& path);
+    MusicHandle loadMusic(const std::string& path);
+
+    // Cache a texture built in code (fallbacks, generated art) under `key`; ready immediately
+    TextureHandle addTexture(const std::string& key, const sf::Image& image);
+    // Cache a sound built from decoded PCM (sound banks) under `key`; ready immediately
+    SoundBufferHandle addSoundBuffer(const std::string& key, const std::int16_t* samples, std::uint64_t sampleCount,
+                                     unsigned int channelCount, unsigned int sampleRate);
+
+    // Upload textures whose files finished decoding. Call once per frame.
+    void update();
+
+    // Block until `handle` is ready or failed, uploading textures meanwhile
+    template <typename T>
+    void finish(const AssetHandle<T>& handle)
+    {
+        while (handle.isLoading()) {
+            update();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    // Drop cached assets no handle refers to any more; returns how many were dropped.
+    // One that only just finished may still be held by its worker and goes on the next call.
+    std::size_t collectUnused();
+
+    // Requests that haven't finished yet (including pending uploads)
+    std::size_t getPendingCount() const { return m_pending.load(std::memory_order_relaxed); }
+
+private:
+    template <typename T>
+    using Cache = std::unordered_map<std::string, std::shared_ptr<AssetSlot<T>>>;
+
+    template <typename T>
+    using SlotPtr = std::shared_ptr<AssetSlot<T>>;
+
+    // Finds `path` in `cache`, or creates a slot and runs `load` for it on a worker.
+    // `load` must end in complete(), either directly or from a queued upload.
+    template <typename T>
+    AssetHandle<T> request(Cache<T>& cache, const std::string& path, std::function<void(const SlotPtr<T>&)> load);
+
+    template <typename T>
+    void complete(AssetSlot<T>& slot, bool ok, const char* kind);
+
+    Cache<sf::Texture> m_textures;
+    Cache<sf::Image> m_images;
+    Cache<sf::Font> m_fonts;
+    Cache<sf::SoundBuffer> m_soundBuffers;
+    Cache<sf::Music> m_music;
+
+    std::mutex m_uploadMutex;
+    std::vector<std::function<void()>> m_uploads;   // Filled by workers, run by update()
+    std::atomic<std::size_t> m_pending{0};
+
+    // Declared last so its workers are joined before anything they write to goes away
+    core::ThreadPool m_pool;
+};
+
+} // namespace game::assets
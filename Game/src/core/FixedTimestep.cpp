@@ -0,0 +1,27 @@
+#include "FixedTimestep.hpp"
+#include <algorithm>
+
+namespace game::core {
+
+FixedTimestep::FixedTimestep(sf::Time step, unsigned int maxStepsPerFrame)
+    : m_step(step)
+    , m_maxStepsPerFrame(std::max(1u, maxStepsPerFrame))
+{
+}
+
+void FixedTimestep::advance(sf::Time frameTime)
+{
+    m_accumulator = std::min(m_accumulator + frameTime, m_step * static_cast<float>(m_maxStepsPerFrame));
+    m_stepsThisFrame = 0;
+}
+
+bool FixedTimestep::step()
+{
+    if (m_accumulator < m_step) return false;
+
+    m_accumulator -= m_step;
+    ++m_stepsThisFrame;
+    return true;
+}
+
+} // namespace game::core
@@ -0,0 +1,37 @@
+#pragma once
+#include <SFML/System/Time.hpp>
+
+namespace game::core {
+
+// Accumulates real frame time and hands it out as whole simulation steps:
+//
+//     timestep.advance(frameTime);
+//     while (timestep.step()) simulate(timestep.getStep());
+//     render(timestep.getAlpha());
+//
+// Gameplay always sees the same dt, whatever the frame rate.
+class FixedTimestep {
+public:
+    explicit FixedTimestep(sf::Time step = sf::seconds(1.f / 120.f), unsigned int maxStepsPerFrame = 8);
+
+    // Add elapsed real time. Anything beyond maxStepsPerFrame steps is dropped, so a long
+    // stall (debugger, window drag) slows the game down instead of spiralling.
+    void advance(sf::Time frameTime);
+
+    // Consume one step if enough time has accumulated
+    bool step();
+
+    // How far rendering is between the previous and the current simulation state, in [0, 1)
+    float getAlpha() const { return m_accumulator / m_step; }
+
+    sf::Time getStep() const { return m_step; }
+    unsigned int getStepsThisFrame() const { return m_stepsThisFrame; }
+
+private:
+    sf::Time m_step;
+    unsigned int m_maxStepsPerFrame;
+    sf::Time m_accumulator = sf::Time::Zero;
+    unsigned int m_stepsThisFrame = 0;
+};
+
+} // namespace game::core
@@ -0,0 +1,173 @@
+#include "Log.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace game::core {
+
+namespace {
+
+const char* levelPrefix(LogLevel level)
+{
+    switch (level) {
+        case LogLevel::Trace:   return "[trace] ";
+        case LogLevel::Debug:   return "[debug] ";
+        case LogLevel::Info:    return "";
+        case LogLevel::Warning: return "[warning] ";
+        case LogLevel::Error:   return "[error] ";
+    }
+    return "";
+}
+
+} // namespace
+
+Logger& Logger::instance()
+{
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger()
+    : m_slots(new Slot[Capacity])
+{
+    for (std::size_t i = 0; i < Capacity; ++i) {
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    m_writer = std::thread(&Logger::writerLoop, this);
+}
+
+Logger::~Logger()
+{
+    // The writer drains whatever is left before it exits
+    m_running.store(false, std::memory_order_release);
+    m_writer.join();
+    delete[] m_slots;
+}
+
+bool Logger::push(const LogRecord& record)
+{
+    std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    while (true) {
+        Slot& slot = m_slots[pos & (Capacity - 1)];
+        std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+
+        if (diff == 0) {
+            // Slot is free for this position; claim it
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.record.level = record.level;
+                slot.record.length = record.length;
+                std::memcpy(slot.record.text, record.text, record.length);
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            // The writer hasn't freed this slot yet: full
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool Logger::pop(LogRecord& record)
+{
+    std::size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+    Slot& slot = m_slots[pos & (Capacity - 1)];
+    std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != pos + 1) {
+        return false;   // Empty, or the producer at this position hasn't finished writing
+    }
+
+    record.level = slot.record.level;
+    record.length = slot.record.length;
+    std::memcpy(record.text, slot.record.text, record.length);
+    slot.sequence.store(pos + Capacity, std::memory_order_release);
+    m_dequeuePos.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+void Logger::flush()
+{
+    std::size_t target = m_enqueuePos.load(std::memory_order_acquire);
+    while (m_dequeuePos.load(std::memory_order_acquire) < target) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void Logger::writerLoop()
+{
+    LogRecord record;
+    std::uint64_t reportedDropped = 0;
+
+    while (true) {
+        // Read the flag first so a final drain still sees everything pushed before shutdown
+        bool running = m_running.load(std::memory_order_acquire);
+
+        bool wroteOut = false;
+        bool wroteErr = false;
+        while (pop(record)) {
+            bool isError = record.level >= LogLevel::Warning;
+            std::ostream& stream = isError ? std::cerr : std::cout;
+            stream << levelPrefix(record.level);
+            stream.write(record.text, record.length);
+            stream << '\n';
+            (isError ? wroteErr : wroteOut) = true;
+        }
+
+        std::uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+        if (dropped != reportedDropped) {
+            std::cerr << "[warning] Log queue full, dropped " << (dropped - reportedDropped) << " messages\n";
+            reportedDropped = dropped;
+            wroteErr = true;
+        }
+
+        // One flush per batch rather than per line
+        if (wroteOut) std::cout.flush();
+        if (wroteErr) std::cerr.flush();
+
+        if (!running) return;
+        if (!wroteOut && !wroteErr) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+}
+
+LogLine& LogLine::append(const char* text, std::size_t length)
+{
+    std::size_t space = LogRecord::MaxLength - m_record.length;
+    if (length > space) length = space;
+    std::memcpy(m_record.text + m_record.length, text, length);
+    m_record.length = static_cast<std::uint16_t>(m_record.length + length);
+    return *this;
+}
+
+LogLine& LogLine::operator<<(const char* text)
+{
+    return text ? append(text, std::strlen(text)) : append("(null)", 6);
+}
+
+LogLine& LogLine::operator<<(double value)
+{
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), "%g", value);
+    return append(buffer, length > 0 ? static_cast<std::size_t>(length) : 0);
+}
+
+LogLine& LogLine::appendSigned(long long value)
+{
+    char buffer[24];
+    int length = std::snprintf(buffer, sizeof(buffer), "%lld", value);
+    return append(buffer, static_cast<std::size_t>(length));
+}
+
+LogLine& LogLine::appendUnsigned(unsigned long long value)
+{
+    char buffer[24];
+    int length = std::snprintf(buffer, sizeof(buffer), "%llu", value);
+    return append(buffer, static_cast<std::size_t>(length));
+}
+
+} // namespace game::core
@@ -0,0 +1,161 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+// Levels as plain integers so the preprocessor can strip whole levels
+#define GAME_LOG_LEVEL_TRACE 0
+#define GAME_LOG_LEVEL_DEBUG 1
+#define GAME_LOG_LEVEL_INFO  2
+#define GAME_LOG_LEVEL_WARN  3
+#define GAME_LOG_LEVEL_ERROR 4
+#define GAME_LOG_LEVEL_OFF   5
+
+// Lowest level compiled in. Calls below it vanish, arguments and all.
+#ifndef GAME_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define GAME_LOG_MIN_LEVEL GAME_LOG_LEVEL_INFO
+#else
+#define GAME_LOG_MIN_LEVEL GAME_LOG_LEVEL_DEBUG
+#endif
+#endif
+
+// Usage: GAME_LOG_INFO("Loaded " << path << " in " << ms << " ms");
+// The message is formatted into a fixed buffer and queued; a background thread does the writing.
+#define GAME_LOG_AT(level, message)                                                   \
+    do {                                                                              \
+        if (::game::core::Logger::instance().isEnabled(level)) {                      \
+            ::game::core::LogLine gameLogLine(level);                                 \
+            gameLogLine << message;                                                   \
+        }                                                                             \
+    } while (0)
+
+#if GAME_LOG_MIN_LEVEL <= GAME_LOG_LEVEL_TRACE
+#define GAME_LOG_TRACE(message) GAME_LOG_AT(::game::core::LogLevel::Trace, message)
+#else
+#define GAME_LOG_TRACE(message) ((void)0)
+#endif
+
+#if GAME_LOG_MIN_LEVEL <= GAME_LOG_LEVEL_DEBUG
+#define GAME_LOG_DEBUG(message) GAME_LOG_AT(::game::core::LogLevel::Debug, message)
+#else
+#define GAME_LOG_DEBUG(message) ((void)0)
+#endif
+
+#if GAME_LOG_MIN_LEVEL <= GAME_LOG_LEVEL_INFO
+#define GAME_LOG_INFO(message) GAME_LOG_AT(::game::core::LogLevel::Info, message)
+#else
+#define GAME_LOG_INFO(message) ((void)0)
+#endif
+
+#if GAME_LOG_MIN_LEVEL <= GAME_LOG_LEVEL_WARN
+#define GAME_LOG_WARN(message) GAME_LOG_AT(::game::core::LogLevel::Warning, message)
+#else
+#define GAME_LOG_WARN(message) ((void)0)
+#endif
+
+#if GAME_LOG_MIN_LEVEL <= GAME_LOG_LEVEL_ERROR
+#define GAME_LOG_ERROR(message) GAME_LOG_AT(::game::core::LogLevel::Error, message)
+#else
+#define GAME_LOG_ERROR(message) ((void)0)
+#endif
+
+namespace game::core {
+
+enum class LogLevel : std::uint8_t {
+    Trace   = GAME_LOG_LEVEL_TRACE,
+    Debug   = GAME_LOG_LEVEL_DEBUG,
+    Info    = GAME_LOG_LEVEL_INFO,
+    Warning = GAME_LOG_LEVEL_WARN,
+    Error   = GAME_LOG_LEVEL_ERROR,
+};
+
+struct LogRecord {
+    static constexpr std::size_t MaxLength = 240;   // Longer messages are truncated
+
+    LogLevel level = LogLevel::Info;
+    std::uint16_t length = 0;
+    char text[MaxLength];
+};
+
+// Owns the queue and the writer thread. Producers never block or allocate:
+// when the queue is full the message is dropped and counted instead.
+class Logger {
+public:
+    static Logger& instance();
+
+    ~Logger();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    bool isEnabled(LogLevel level) const { return level >= m_level.load(std::memory_order_relaxed); }
+    void setLevel(LogLevel level) { m_level.store(level, std::memory_order_relaxed); }
+
+    // Returns false if the queue was full
+    bool push(const LogRecord& record);
+
+    // Block until everything queued so far has been written
+    void flush();
+
+private:
+    Logger();
+
+    // Bounded multi-producer queue (Vyukov): each slot's sequence number says whether
+    // it is free for the producer at that position or ready for the consumer
+    static constexpr std::size_t Capacity = 2048;   // Power of two
+
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        LogRecord record;
+    };
+
+    bool pop(LogRecord& record);
+    void writerLoop();
+
+    Slot* m_slots;
+    alignas(64) std::atomic<std::size_t> m_enqueuePos{0};
+    alignas(64) std::atomic<std::size_t> m_dequeuePos{0};   // Advanced by the writer only
+    std::atomic<std::uint64_t> m_dropped{0};
+    std::atomic<LogLevel> m_level{LogLevel::Trace};         // Runtime filter on top of GAME_LOG_MIN_LEVEL
+    std::atomic<bool> m_running{true};
+    std::thread m_writer;
+};
+
+// Formats one message into a stack buffer and queues it when it goes out of scope
+class LogLine {
+public:
+    explicit LogLine(LogLevel level) { m_record.level = level; }
+    ~LogLine() { Logger::instance().push(m_record); }
+
+    LogLine(const LogLine&) = delete;
+    LogLine& operator=(const LogLine&) = delete;
+
+    LogLine& operator<<(const char* text);
+    LogLine& operator<<(const std::string& text) { return append(text.data(), text.size()); }
+    LogLine& operator<<(char c) { return append(&c, 1); }
+    LogLine& operator<<(double value);
+    LogLine& operator<<(float value) { return *this << static_cast<double>(value); }
+
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    LogLine& operator<<(T value)
+    {
+        if constexpr (std::is_signed_v<T>) {
+            return appendSigned(static_cast<long long>(value));
+        } else {
+            return appendUnsigned(static_cast<unsigned long long>(value));
+        }
+    }
+
+private:
+    LogLine& append(const char* text, std::size_t length);
+    LogLine& appendSigned(long long value);
+    LogLine& appendUnsigned(unsigned long long value);
+
+    LogRecord m_record;
+};
+
+} // namespace game::core
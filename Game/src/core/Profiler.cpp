@@ -0,0 +1,176 @@
+#include "Profiler.hpp"
+#include "Log.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+
+namespace game::core {
+
+namespace {
+
+const std::chrono::steady_clock::time_point ProfilerEpoch = std::chrono::steady_clock::now();
+
+// Zone names are string literals, but escape them anyway so the JSON is always valid
+void writeJsonString(std::ostream& out, const char* text)
+{
+    out << '"';
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') out << '\\';
+        out << *c;
+    }
+    out << '"';
+}
+
+} // namespace
+
+Profiler& Profiler::instance()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+std::uint64_t Profiler::now()
+{
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - ProfilerEpoch).count());
+}
+
+ProfileBuffer& Profiler::getThreadBuffer()
+{
+    struct Lease {
+        ProfileBuffer& buffer;
+        ~Lease() { Profiler::instance().releaseBuffer(buffer); }
+    };
+    thread_local Lease lease{acquireBuffer()};
+    return lease.buffer;
+}
+
+ProfileBuffer& Profiler::acquireBuffer()
+{
+    // Buffers are never freed, only reused, so readers never see freed memory. A reused buffer
+    // keeps its older events (and trace thread id) from the thread that had it before.
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& buffer : m_buffers) {
+        if (!buffer->m_inUse) {
+            buffer->m_inUse = true;
+            return *buffer;
+        }
+    }
+    m_buffers.push_back(std::make_unique<ProfileBuffer>(static_cast<std::uint32_t>(m_buffers.size())));
+    return *m_buffers.back();
+}
+
+void Profiler::releaseBuffer(ProfileBuffer& buffer)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    buffer.m_inUse = false;
+}
+
+void Profiler::endFrame()
+{
+    std::vector<ProfileBuffer*> buffers;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& buffer : m_buffers) buffers.push_back(buffer.get());
+    }
+
+    for (ProfileBuffer* buffer : buffers) {
+        std::uint64_t written = buffer->m_written.load(std::memory_order_acquire);
+
+        // Anything older than one ring has already been overwritten
+        std::uint64_t first = std::max(buffer->m_consumed, written > ProfileBuffer::Capacity ? written - ProfileBuffer::Capacity : 0);
+        ProfileEvent event;
+        for (std::uint64_t i = first; i < written; ++i) {
+            if (!buffer->read(i, event)) continue;   // Lapped by the writer
+            ZoneHistory& zone = m_zones[event.name];
+            zone.currentMs += (event.end - event.start) / 1e6;
+            ++zone.currentCalls;
+        }
+        buffer->m_consumed = written;
+    }
+
+    std::size_t slot = m_frameCount % HistoryFrames;
+    for (auto& [name, zone] : m_zones) {
+        zone.frameMs[slot] = zone.currentMs;
+        zone.lastCalls = zone.currentCalls;
+        zone.currentMs = 0.0;
+        zone.currentCalls = 0;
+    }
+    ++m_frameCount;
+}
+
+std::vector<Profiler::ZoneStats> Profiler::getStats() const
+{
+    std::size_t frames = std::min(m_frameCount, HistoryFrames);
+
+    // Sum histories that share a name, sorted by name
+    std::map<std::string, ZoneHistory> merged;
+    for (const auto& [name, zone] : m_zones) {
+        ZoneHistory& total = merged[name];
+        for (std::size_t i = 0; i < frames; ++i) total.frameMs[i] += zone.frameMs[i];
+        total.lastCalls += zone.lastCalls;
+    }
+
+    std::vector<ZoneStats> stats;
+    stats.reserve(merged.size());
+    for (const auto& [name, zone] : merged) {
+        ZoneStats entry;
+        entry.name = name;
+        entry.calls = zone.lastCalls;
+        for (std::size_t i = 0; i < frames; ++i) {
+            entry.averageMs += zone.frameMs[i];
+            entry.worstMs = std::max(entry.worstMs, zone.frameMs[i]);
+        }
+        if (frames > 0) entry.averageMs /= frames;
+        stats.push_back(entry);
+    }
+    return stats;
+}
+
+bool Profiler::writeChromeTrace(const std::string& path)
+{
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) {
+        GAME_LOG_ERROR("Failed to create profile trace: " << path);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    file << std::fixed << std::setprecision(3);
+    file << "{\"traceEvents\":[\n";
+    bool first = true;
+    std::size_t count = 0;
+    for (const auto& buffer : m_buffers) {
+        std::uint64_t written = buffer->m_written.load(std::memory_order_acquire);
+        std::uint64_t begin = written > ProfileBuffer::Capacity ? written - ProfileBuffer::Capacity : 0;
+
+        ProfileEvent event;
+        for (std::uint64_t i = begin; i < written; ++i) {
+            if (!buffer->read(i, event)) continue;
+            if (!first) file << ",\n";
+            first = false;
+
+            // Complete events, timestamps in microseconds
+            file << "{\"name\":";
+            writeJsonString(file, event.name);
+            file << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->m_threadIndex
+                 << ",\"ts\":" << event.start / 1000.0
+                 << ",\"dur\":" << (event.end - event.start) / 1000.0 << "}";
+            ++count;
+        }
+    }
+    file << "\n]}\n";
+
+    if (!file) {
+        GAME_LOG_ERROR("Failed to write profile trace: " << path);
+        return false;
+    }
+
+    GAME_LOG_INFO("Profile trace written: " << path << " (" << count << " events)");
+    return true;
+}
+
+} // namespace game::core
@@ -0,0 +1,154 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Time the enclosing scope under `name` (a string literal). Compiles to nothing with GAME_DISABLE_PROFILER.
+#ifndef GAME_DISABLE_PROFILER
+#define GAME_PROFILE_CONCAT_INNER(a, b) a##b
+#define GAME_PROFILE_CONCAT(a, b) GAME_PROFILE_CONCAT_INNER(a, b)
+#define GAME_PROFILE_ZONE(name) ::game::core::ProfileZone GAME_PROFILE_CONCAT(profileZone, __LINE__)(name)
+#else
+#define GAME_PROFILE_ZONE(name) ((void)0)
+#endif
+
+namespace game::core {
+
+struct ProfileEvent {
+    const char* name = nullptr;
+    std::uint64_t start = 0;   // Nanoseconds since the profiler started
+    std::uint64_t end = 0;
+};
+
+// Events recorded by one thread. Only the owning thread writes; other threads copy events out
+// with read(), which detects a slot being overwritten under it (per-slot sequence numbers, as
+// in a seqlock). Old events are overwritten once the ring is full.
+class ProfileBuffer {
+public:
+    static constexpr std::size_t Capacity = 1u << 14;
+
+    explicit ProfileBuffer(std::uint32_t threadIndex) : m_threadIndex(threadIndex) {}
+
+    void push(const ProfileEvent& event)
+    {
+        std::uint64_t index = m_written.load(std::memory_order_relaxed);
+        Slot& slot = m_slots[index & (Capacity - 1)];
+        slot.sequence.store(index * 2 + 1, std::memory_order_relaxed);   // Odd while rewriting
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.name.store(event.name, std::memory_order_relaxed);
+        slot.start.store(event.start, std::memory_order_relaxed);
+        slot.end.store(event.end, std::memory_order_relaxed);
+        slot.sequence.store(index * 2 + 2, std::memory_order_release);
+        m_written.store(index + 1, std::memory_order_release);
+    }
+
+    // Copy out event number `index`; false if it has been (or is being) overwritten
+    bool read(std::uint64_t index, ProfileEvent& event) const
+    {
+        const Slot& slot = m_slots[index & (Capacity - 1)];
+        std::uint64_t sequence = index * 2 + 2;
+        if (slot.sequence.load(std::memory_order_acquire) != sequence) return false;
+        event.name = slot.name.load(std::memory_order_relaxed);
+        event.start = slot.start.load(std::memory_order_relaxed);
+        event.end = slot.end.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return slot.sequence.load(std::memory_order_relaxed) == sequence;
+    }
+
+private:
+    friend class Profiler;
+
+    struct Slot {
+        std::atomic<std::uint64_t> sequence{0};
+        std::atomic<const char*> name{nullptr};
+        std::atomic<std::uint64_t> start{0};
+        std::atomic<std::uint64_t> end{0};
+    };
+
+    std::array<Slot, Capacity> m_slots;
+    std::atomic<std::uint64_t> m_written{0};
+    std::uint64_t m_consumed = 0;   // Read position for Profiler::endFrame(), main thread only
+    std::uint32_t m_threadIndex;
+    bool m_inUse = true;            // Owned by a live thread; guarded by Profiler::m_mutex
+};
+
+// Collects zone timings from every thread and keeps rolling per-zone statistics
+class Profiler {
+public:
+    static constexpr std::size_t HistoryFrames = 120;
+
+    struct ZoneStats {
+        std::string name;
+        double averageMs = 0.0;   // Mean time per frame over the history
+        double worstMs = 0.0;     // Slowest single frame in the history
+        std::uint32_t calls = 0;  // Calls in the last frame
+    };
+
+    static Profiler& instance();
+
+    // Monotonic nanoseconds since the profiler was created
+    static std::uint64_t now();
+
+    // The calling thread's buffer, taken on first use. It goes back to the pool when the thread
+    // exits and is handed to the next new thread, so short-lived workers don't each keep one.
+    ProfileBuffer& getThreadBuffer();
+
+    // Fold everything recorded since the last call into the history (main thread, once per frame)
+    void endFrame();
+
+    std::vector<ZoneStats> getStats() const;
+
+    // Write the events still held in the ring buffers as a Chrome trace (chrome://tracing, Perfetto)
+    bool writeChromeTrace(const std::string& path);
+
+private:
+    Profiler() = default;
+
+    struct ZoneHistory {
+        std::array<double, HistoryFrames> frameMs{};
+        double currentMs = 0.0;
+        std::uint32_t currentCalls = 0;
+        std::uint32_t lastCalls = 0;
+    };
+
+    ProfileBuffer& acquireBuffer();
+    void releaseBuffer(ProfileBuffer& buffer);
+
+    std::mutex m_mutex;   // Guards m_buffers
+    std::vector<std::unique_ptr<ProfileBuffer>> m_buffers;
+
+    // Keyed by the literal itself so the per-frame fold never builds a string; main thread only.
+    // The same name used from two translation units may be two entries, merged in getStats().
+    std::unordered_map<const char*, ZoneHistory> m_zones;
+    std::size_t m_frameCount = 0;
+};
+
+// RAII marker; use GAME_PROFILE_ZONE rather than naming one directly
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name)
+        : m_name(name)
+        , m_start(Profiler::now())
+    {
+    }
+
+    ~ProfileZone()
+    {
+        thread_local ProfileBuffer& buffer = Profiler::instance().getThreadBuffer();
+        buffer.push({m_name, m_start, Profiler::now()});
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char* m_name;
+    std::uint64_t m_start;
+};
+
+} // namespace game::core
@@ -0,0 +1,53 @@
+#include "ProfilerOverlay.hpp"
+#include "Profiler.hpp"
+#include <cstdio>
+
+namespace game::core {
+
+namespace {
+
+constexpr unsigned int RefreshInterval = 15;   // Frames between text rebuilds
+
+} // namespace
+
+ProfilerOverlay::ProfilerOverlay(const sf::Font& font)
+    : m_text(font, "", 13u)
+{
+    m_text.setFillColor(sf::Color::White);
+    m_text.setPosition({12.f, 34.f});
+    m_background.setFillColor(sf::Color(0, 0, 0, 170));
+    m_background.setPosition({8.f, 30.f});
+}
+
+void ProfilerOverlay::update(const Profiler& profiler)
+{
+    if (!m_visible) return;
+    if (m_framesUntilRefresh > 0) {
+        --m_framesUntilRefresh;
+        return;
+    }
+    m_framesUntilRefresh = RefreshInterval;
+
+    std::string text = "zone                          avg ms   worst ms   calls\n";
+    char line[128];
+    for (const auto& zone : profiler.getStats()) {
+        std::snprintf(line, sizeof(line), "%-28s %8.3f %10.3f %7u\n",
+                      zone.name.c_str(), zone.averageMs, zone.worstMs, zone.calls);
+        text += line;
+    }
+    text += "F3 hide, F4 write profile.json";
+
+    m_text.setString(text);
+    sf::FloatRect bounds = m_text.getLocalBounds();
+    m_background.setSize({bounds.position.x + bounds.size.x + 8.f, bounds.position.y + bounds.size.y + 8.f});
+}
+
+void ProfilerOverlay::draw(sf::RenderTarget& target) const
+{
+    if (!m_visible) return;
+
+    target.draw(m_background);
+    target.draw(m_text);
+}
+
+} // namespace game::core
@@ -0,0 +1,27 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+
+namespace game::core {
+
+class Profiler;
+
+// Table of per-zone average and worst frame times, drawn in screen space
+class ProfilerOverlay {
+public:
+    explicit ProfilerOverlay(const sf::Font& font);
+
+    // Refreshes the text a few times a second; call once per frame after Profiler::endFrame()
+    void update(const Profiler& profiler);
+    void draw(sf::RenderTarget& target) const;
+
+    void toggle() { m_visible = !m_visible; m_framesUntilRefresh = 0; }
+    bool isVisible() const { return m_visible; }
+
+private:
+    sf::Text m_text;
+    sf::RectangleShape m_background;
+    unsigned int m_framesUntilRefresh = 0;
+    bool m_visible = false;
+};
+
+} // namespace game::core
@@ -0,0 +1,64 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace game::core {
+
+// Bounded single-producer/single-consumer queue. Neither side blocks or allocates, so
+// either can be a real-time audio thread. One thread may push and one (other) thread may pop.
+template <typename T, std::size_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // Producer only; false (and nothing written) when full
+    bool push(const T& value)
+    {
+        std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) == Capacity) return false;
+
+        m_slots[head & (Capacity - 1)] = value;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only; false when empty
+    bool pop(T& value)
+    {
+        std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire)) return false;
+
+        value = m_slots[tail & (Capacity - 1)];
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only; drops the oldest entry without copying it out
+    bool discard()
+    {
+        std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire)) return false;
+
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Exact from the consumer's side; a snapshot from anywhere else
+    std::size_t size() const
+    {
+        // Tail first: head only grows, so this never goes negative
+        std::size_t tail = m_tail.load(std::memory_order_acquire);
+        return m_head.load(std::memory_order_acquire) - tail;
+    }
+
+    static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    // Each index on its own cache line so the two sides don't fight over it
+    alignas(64) std::atomic<std::size_t> m_head{0};   // Next slot to write
+    alignas(64) std::atomic<std::size_t> m_tail{0};   // Next slot to read
+    alignas(64) std::array<T, Capacity> m_slots{};
+};
+
+} // namespace game::core
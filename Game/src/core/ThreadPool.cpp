@@ -0,0 +1,95 @@
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <atomic>
+
+namespace game::core {
+
+ThreadPool::ThreadPool(unsigned int threadCount)
+{
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    m_workers.reserve(threadCount - 1);
+    for (unsigned int i = 1; i < threadCount; ++i) {
+        m_workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_condition.notify_all();
+
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    if (m_workers.empty()) {
+        task();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    m_condition.notify_one();
+}
+
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& fn)
+{
+    if (count == 0) return;
+
+    // Items are handed out one at a time from a shared counter so uneven items balance themselves
+    std::atomic<std::size_t> next{0};
+    std::size_t helpers = std::min(m_workers.size(), count - 1);
+    std::size_t finished = 0;
+    std::mutex doneMutex;
+    std::condition_variable doneCondition;
+
+    auto drain = [&next, count, &fn]() {
+        for (std::size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            fn(i);
+        }
+    };
+
+    for (std::size_t h = 0; h < helpers; ++h) {
+        submit([&]() {
+            drain();
+            std::lock_guard<std::mutex> lock(doneMutex);
+            ++finished;
+            doneCondition.notify_one();
+        });
+    }
+
+    drain();
+
+    // Helpers reference this stack frame, so wait for every one of them, not just for the items
+    std::unique_lock<std::mutex> lock(doneMutex);
+    doneCondition.wait(lock, [&]() { return finished == helpers; });
+}
+
+void ThreadPool::workerLoop()
+{
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+            if (m_stop && m_tasks.empty()) return;
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
+
+} // namespace game::core
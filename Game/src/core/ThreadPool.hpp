@@ -0,0 +1,40 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace game::core {
+
+// Fixed set of worker threads. The thread calling parallelFor() also takes part,
+// so a pool of N threads spawns N - 1 workers (a pool of 1 runs everything inline).
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned int threadCount = 0); // 0 = one per hardware thread
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned int getThreadCount() const { return static_cast<unsigned int>(m_workers.size()) + 1; }
+
+    // Queue a task for any worker (runs inline if the pool has no workers)
+    void submit(std::function<void()> task);
+
+    // Run fn(i) for every i in [0, count) and block until all calls have returned
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& fn);
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> m_workers;
+    std::deque<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_stop = false;
+};
+
+} // namespace game::core
@@ -0,0 +1,45 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+
+namespace game::ecs {
+
+// Entities are circles for now: centre position plus collision radius
+struct Transform {
+    sf::Vector2f position;
+    float radius = 16.f;
+    sf::Vector2f previousPosition;   // Position one simulation step ago, for render interpolation
+};
+
+struct Health {
+    float current = 1.f;
+    float max = 1.f;
+};
+
+// White flash after taking damage
+struct Flash {
+    sf::Time remaining = sf::Time::Zero;
+    sf::Time duration = sf::seconds(0.2f);
+};
+
+// Chase the player when close, otherwise wander in a random direction
+struct AIState {
+    sf::Vector2f moveDirection{1.f, 0.f};
+    float speed = 80.f;                       // px/sec
+    float detectionRange = 300.f;
+    sf::Time wanderTimer = sf::Time::Zero;
+    sf::Time wanderInterval = sf::seconds(2.f);
+};
+
+// Fires along the move direction every cooldown
+struct Shooter {
+    sf::Time cooldown = sf::seconds(1.5f);
+    sf::Time timer = sf::Time::Zero;
+    float projectileSpeed = 150.f;
+    float projectileRadius = 4.f;
+};
+
+struct Appearance {
+    sf::Color color = sf::Color::White;
+};
+
+} // namespace game::ecs
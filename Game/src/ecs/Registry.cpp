@@ -0,0 +1,47 @@
+#include "Registry.hpp"
+
+namespace game::ecs {
+
+Entity Registry::create()
+{
+    std::uint32_t index;
+    if (!m_freeIndices.empty()) {
+        index = m_freeIndices.back();
+        m_freeIndices.pop_back();
+    } else {
+        index = static_cast<std::uint32_t>(m_generations.size());
+        m_generations.push_back(0);
+    }
+    return (m_generations[index] << EntityIndexBits) | index;
+}
+
+void Registry::destroy(Entity entity)
+{
+    if (!isValid(entity)) return;
+
+    std::apply([entity](auto&... sets) { (sets.remove(entity), ...); }, m_storage);
+
+    std::uint32_t index = entityIndex(entity);
+    m_generations[index] = (m_generations[index] + 1) & (0xFFFFFFFFu >> EntityIndexBits);
+    m_freeIndices.push_back(index);
+}
+
+bool Registry::isValid(Entity entity) const
+{
+    std::uint32_t index = entityIndex(entity);
+    return index < m_generations.size() && m_generations[index] == entityGeneration(entity);
+}
+
+void Registry::clear()
+{
+    std::apply([](auto&... sets) { (sets.clear(), ...); }, m_storage);
+
+    // Keep the slots but invalidate every id handed out so far
+    m_freeIndices.clear();
+    for (std::uint32_t index = 0; index < m_generations.size(); ++index) {
+        m_generations[index] = (m_generations[index] + 1) & (0xFFFFFFFFu >> EntityIndexBits);
+        m_freeIndices.push_back(index);
+    }
+}
+
+} // namespace game::ecs
@@ -0,0 +1,131 @@
+#pragma once
+#include "Components.hpp"
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+namespace game::ecs {
+
+// Low bits index the entity slot, high bits count how often the slot was reused
+using Entity = std::uint32_t;
+
+constexpr std::uint32_t EntityIndexBits = 20;
+constexpr std::uint32_t EntityIndexMask = (1u << EntityIndexBits) - 1;
+
+inline std::uint32_t entityIndex(Entity entity) { return entity & EntityIndexMask; }
+inline std::uint32_t entityGeneration(Entity entity) { return entity >> EntityIndexBits; }
+
+// Components of one type packed next to each other, with a sparse index per entity slot.
+// Removal swaps the last element into the hole, so iteration order is not stable.
+template <typename T>
+class SparseSet {
+public:
+    T& insert(Entity entity, const T& component)
+    {
+        std::uint32_t index = entityIndex(entity);
+        if (index >= m_sparse.size()) {
+            m_sparse.resize(index + 1, Invalid);
+        }
+
+        if (m_sparse[index] != Invalid) {
+            m_dense[m_sparse[index]] = entity;
+            return m_components[m_sparse[index]] = component;
+        }
+
+        m_sparse[index] = static_cast<std::uint32_t>(m_dense.size());
+        m_dense.push_back(entity);
+        m_components.push_back(component);
+        return m_components.back();
+    }
+
+    void remove(Entity entity)
+    {
+        if (!contains(entity)) return;
+
+        std::uint32_t hole = m_sparse[entityIndex(entity)];
+        std::uint32_t last = static_cast<std::uint32_t>(m_dense.size() - 1);
+        if (hole != last) {
+            m_dense[hole] = m_dense[last];
+            m_components[hole] = std::move(m_components[last]);
+            m_sparse[entityIndex(m_dense[hole])] = hole;
+        }
+
+        m_dense.pop_back();
+        m_components.pop_back();
+        m_sparse[entityIndex(entity)] = Invalid;
+    }
+
+    bool contains(Entity entity) const
+    {
+        std::uint32_t index = entityIndex(entity);
+        return index < m_sparse.size() && m_sparse[index] != Invalid && m_dense[m_sparse[index]] == entity;
+    }
+
+    // Only valid if contains(entity)
+    T& get(Entity entity) { return m_components[m_sparse[entityIndex(entity)]]; }
+    const T& get(Entity entity) const { return m_components[m_sparse[entityIndex(entity)]]; }
+
+    T* find(Entity entity) { return contains(entity) ? &get(entity) : nullptr; }
+    const T* find(Entity entity) const { return contains(entity) ? &get(entity) : nullptr; }
+
+    void clear()
+    {
+        m_sparse.clear();
+        m_dense.clear();
+        m_components.clear();
+    }
+
+    // Packed arrays for systems; entities()[i] owns components()[i]
+    std::size_t size() const { return m_dense.size(); }
+    const std::vector<Entity>& entities() const { return m_dense; }
+    std::vector<T>& components() { return m_components; }
+    const std::vector<T>& components() const { return m_components; }
+
+private:
+    static constexpr std::uint32_t Invalid = 0xFFFFFFFFu;
+
+    std::vector<std::uint32_t> m_sparse;   // Entity index -> dense position
+    std::vector<Entity> m_dense;
+    std::vector<T> m_components;
+};
+
+// Owns every entity id and one SparseSet per component type
+class Registry {
+public:
+    Entity create();
+    void destroy(Entity entity);
+    bool isValid(Entity entity) const;
+    void clear();
+
+    std::size_t getEntityCount() const { return m_generations.size() - m_freeIndices.size(); }
+
+    template <typename T>
+    SparseSet<T>& storage() { return std::get<SparseSet<T>>(m_storage); }
+
+    template <typename T>
+    const SparseSet<T>& storage() const { return std::get<SparseSet<T>>(m_storage); }
+
+    template <typename T>
+    T& add(Entity entity, const T& component = T{}) { return storage<T>().insert(entity, component); }
+
+    template <typename T>
+    T* find(Entity entity) { return storage<T>().find(entity); }
+
+    template <typename T>
+    const T* find(Entity entity) const { return storage<T>().find(entity); }
+
+private:
+    std::vector<std::uint32_t> m_generations;
+    std::vector<std::uint32_t> m_freeIndices;
+
+    std::tuple<
+        SparseSet<Transform>,
+        SparseSet<Health>,
+        SparseSet<Flash>,
+        SparseSet<AIState>,
+        SparseSet<Shooter>,
+        SparseSet<Appearance>
+    > m_storage;
+};
+
+} // namespace game::ecs
@@ -0,0 +1,156 @@
+#include "Systems.hpp"
+#include "../graphics/SpriteBatch.hpp"
+#include "../projectiles/ProjectilePool.hpp"
+#include "../world/SpatialHash.hpp"
+#include "../world/World.hpp"
+#include "../core/Log.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace game::ecs {
+
+void updateAI(Registry& registry, const sf::Vector2f& playerPos, const sf::Time& dt, std::mt19937& rng)
+{
+    std::uniform_real_distribution<float> angleDist(0.f, 6.28318f);
+
+    auto& states = registry.storage<AIState>();
+    auto& transforms = registry.storage<Transform>();
+    const auto& entities = states.entities();
+    auto& ai = states.components();
+
+    for (std::size_t i = 0; i < ai.size(); ++i) {
+        const Transform* transform = transforms.find(entities[i]);
+        if (!transform) continue;
+
+        sf::Vector2f dir = playerPos - transform->position;
+        float distance = std::sqrt(dir.x * dir.x + dir.y * dir.y);
+
+        if (distance < ai[i].detectionRange && distance > 1.f) {
+            ai[i].moveDirection = dir / distance;
+        } else {
+            // Wander behavior - change direction occasionally
+            ai[i].wanderTimer += dt;
+            if (ai[i].wanderTimer > ai[i].wanderInterval) {
+                float angle = angleDist(rng);
+                ai[i].moveDirection = {std::cos(angle), std::sin(angle)};
+                ai[i].wanderTimer = sf::Time::Zero;
+            }
+        }
+    }
+}
+
+void updateMovement(Registry& registry, const game::world::World& world, const sf::Time& dt)
+{
+    auto& states = registry.storage<AIState>();
+    auto& transforms = registry.storage<Transform>();
+    const auto& entities = states.entities();
+    const auto& ai = states.components();
+    const float seconds = dt.asSeconds();
+
+    for (std::size_t i = 0; i < ai.size(); ++i) {
+        Transform* transform = transforms.find(entities[i]);
+        if (!transform) continue;
+
+        sf::Vector2f move = ai[i].moveDirection * ai[i].speed * seconds;
+        transform->previousPosition = transform->position;
+        transform->position += world.moveAndSlide(getBounds(*transform), move);
+    }
+}
+
+void updateFlash(Registry& registry, const sf::Time& dt)
+{
+    for (Flash& flash : registry.storage<Flash>().components()) {
+        flash.remaining = std::max(sf::Time::Zero, flash.remaining - dt);
+    }
+}
+
+void updateShooters(Registry& registry, game::projectiles::ProjectilePool& projectiles, const sf::Time& dt)
+{
+    auto& shooters = registry.storage<Shooter>();
+    const auto& entities = shooters.entities();
+    auto& shooter = shooters.components();
+
+    for (std::size_t i = 0; i < shooter.size(); ++i) {
+        shooter[i].timer += dt;
+        if (shooter[i].timer < shooter[i].cooldown) continue;
+        shooter[i].timer = sf::Time::Zero;
+
+        const Transform* transform = registry.find<Transform>(entities[i]);
+        if (!transform) continue;
+
+        // Shoot in the direction the entity is moving
+        const AIState* ai = registry.find<AIState>(entities[i]);
+        sf::Vector2f shootDir = ai ? ai->moveDirection : sf::Vector2f(1.f, 0.f);
+        projectiles.spawn(transform->position, shootDir * shooter[i].projectileSpeed,
+                          shooter[i].projectileRadius, game::world::SpatialCategory::Enemy);
+    }
+}
+
+bool applyDamage(Registry& registry, Entity entity, float amount)
+{
+    Health* health = registry.find<Health>(entity);
+    if (!health || health->current <= 0.f) return false;
+
+    health->current = std::max(0.f, health->current - amount);
+    if (Flash* flash = registry.find<Flash>(entity)) {
+        flash->remaining = flash->duration;
+    }
+
+    GAME_LOG_DEBUG("Enemy took " << amount << " damage! Health: " << health->current << "/" << health->max);
+
+    if (health->current <= 0.f) {
+        GAME_LOG_DEBUG("Enemy died!");
+        return true;
+    }
+    return false;
+}
+
+void destroyDead(Registry& registry)
+{
+    const auto& healths = registry.storage<Health>();
+
+    std::vector<Entity> dead;
+    for (std::size_t i = 0; i < healths.size(); ++i) {
+        if (healths.components()[i].current <= 0.f) {
+            dead.push_back(healths.entities()[i]);
+        }
+    }
+
+    for (Entity entity : dead) {
+        registry.destroy(entity);
+    }
+}
+
+sf::FloatRect getBounds(const Transform& transform)
+{
+    return sf::FloatRect(
+        sf::Vector2f(transform.position.x - transform.radius, transform.position.y - transform.radius),
+        sf::Vector2f(transform.radius * 2.f, transform.radius * 2.f)
+    );
+}
+
+void drawEntities(const Registry& registry, game::graphics::SpriteBatch& batch,
+                  const game::graphics::AtlasRegion& circle, const sf::FloatRect& viewBounds, float alpha)
+{
+    const auto& appearances = registry.storage<Appearance>();
+    const auto& transforms = registry.storage<Transform>();
+    const auto& flashes = registry.storage<Flash>();
+    const auto& entities = appearances.entities();
+    const auto& appearance = appearances.components();
+
+    for (std::size_t i = 0; i < appearance.size(); ++i) {
+        const Transform* transform = transforms.find(entities[i]);
+        if (!transform || !viewBounds.findIntersection(getBounds(*transform))) continue;
+
+        // Flash white when taking damage
+        const Flash* flash = flashes.find(entities[i]);
+        sf::Color color = flash && flash->remaining > sf::Time::Zero ? sf::Color::White : appearance[i].color;
+
+        sf::Vector2f position = transform->previousPosition + (transform->position - transform->previousPosition) * alpha;
+        float r = transform->radius;
+        batch.draw(game::graphics::Layer::Enemies, circle,
+                   sf::FloatRect({position.x - r, position.y - r}, {r * 2.f, r * 2.f}), color);
+    }
+}
+
+} // namespace game::ecs
@@ -0,0 +1,38 @@
+#pragma once
+#include "Registry.hpp"
+#include <SFML/Graphics.hpp>
+#include <random>
+
+namespace game::world { class World; }
+namespace game::projectiles { class ProjectilePool; }
+namespace game::graphics { class SpriteBatch; struct AtlasRegion; }
+
+namespace game::ecs {
+
+// Systems walk the packed component arrays directly; run them in this order every simulation step
+
+// Pick a move direction: towards the player when in range, otherwise wander.
+// Wander directions come from `rng`, so a seeded generator makes runs repeatable.
+void updateAI(Registry& registry, const sf::Vector2f& playerPos, const sf::Time& dt, std::mt19937& rng);
+
+// Move along the AI direction, sliding along walls
+void updateMovement(Registry& registry, const game::world::World& world, const sf::Time& dt);
+
+void updateFlash(Registry& registry, const sf::Time& dt);
+
+void updateShooters(Registry& registry, game::projectiles::ProjectilePool& projectiles, const sf::Time& dt);
+
+// Returns true if this hit killed the entity
+bool applyDamage(Registry& registry, Entity entity, float amount);
+
+// Destroy every entity whose health reached zero
+void destroyDead(Registry& registry);
+
+sf::FloatRect getBounds(const Transform& transform);
+
+// Queue a tinted `circle` quad for every visible entity with an Appearance.
+// alpha interpolates between the previous and the current step.
+void drawEntities(const Registry& registry, game::graphics::SpriteBatch& batch,
+                  const game::graphics::AtlasRegion& circle, const sf::FloatRect& viewBounds, float alpha = 1.f);
+
+} // namespace game::ecs
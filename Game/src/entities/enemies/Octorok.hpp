@@ -1,40 +1,10 @@
 #pragma once
-#include "../Enemy.hpp"  // Go up one directory to entities/
-#include "../../projectiles/Projectile.hpp"  // Go up two directories
-#include <vector>
-#include <memory>
+#include "../../ecs/Registry.hpp"
 
 namespace game::enemies {
 
-class Octorok : public Enemy {
-public:
-    Octorok(const sf::Vector2f& position);
-    
-    void update(const sf::Time& dt) override;
-    void draw(sf::RenderTarget& target) const override;
-    
-    void updateAI(const sf::Vector2f& playerPos) override;
-    
-    // Projectile management
-    std::vector<std::shared_ptr<game::projectiles::Projectile>>& getProjectiles() 
-    { 
-        return m_projectiles; 
-    }
-    
-    const std::vector<std::shared_ptr<game::projectiles::Projectile>>& getProjectiles() const 
-    { 
-        return m_projectiles; 
-    }
-    
-private:
-    void shootProjectile();
-    
-    float m_detectionRange = 300.f;
-    float m_shootCooldown = 1.5f;
-    sf::Time m_shootTimer = sf::Time::Zero;
-    sf::Time m_moveTimer = sf::Time::Zero;
-    
-    std::vector<std::shared_ptr<game::projectiles::Projectile>> m_projectiles;
-};
+// Octoroks chase the player when close, wander otherwise, and shoot along their move direction.
+// Their behaviour lives in the ECS systems; this just assembles the components.
+game::ecs::Entity spawnOctorok(game::ecs::Registry& registry, const sf::Vector2f& position);
 
-} // namespace game::enemies
\ No newline at end of file
+} // namespace game::enemies
@@ -0,0 +1,100 @@
+#include "SpriteBatch.hpp"
+#include "../core/Profiler.hpp"
+#include <algorithm>
+
+namespace game::graphics {
+
+void SpriteBatch::draw(Layer layer, const AtlasRegion& region, const sf::FloatRect& bounds, const sf::Color& color)
+{
+    sf::Vector2f min = bounds.position;
+    sf::Vector2f max = bounds.position + bounds.size;
+    push(layer, region, {min, {max.x, min.y}, max, {min.x, max.y}}, color);
+}
+
+void SpriteBatch::draw(Layer layer, const AtlasRegion& region, const sf::Vector2f& position, const sf::Vector2f& size,
+                       const sf::Vector2f& origin, sf::Angle rotation, const sf::Color& color)
+{
+    sf::Transform transform;
+    transform.translate(position).rotate(rotation).translate(-origin);
+    push(layer, region,
+         {transform.transformPoint({0.f, 0.f}), transform.transformPoint({size.x, 0.f}),
+          transform.transformPoint(size), transform.transformPoint({0.f, size.y})},
+         color);
+}
+
+void SpriteBatch::push(Layer layer, const AtlasRegion& region, const std::array<sf::Vector2f, 4>& corners,
+                       const sf::Color& color)
+{
+    std::uint64_t index = m_quads.size();
+    m_keys.push_back((static_cast<std::uint64_t>(layer) << 56) |
+                     (static_cast<std::uint64_t>(getTextureId(region.texture)) << 32) | index);
+    m_quads.push_back({corners, region.rect, color});
+}
+
+std::uint32_t SpriteBatch::getTextureId(const sf::Texture* texture)
+{
+    if (!texture) return 0;
+
+    // A frame only ever sees a handful of textures, so a linear scan beats hashing
+    for (std::size_t i = 1; i < m_textures.size(); ++i) {
+        if (m_textures[i] == texture) return static_cast<std::uint32_t>(i);
+    }
+    if (m_textures.empty()) m_textures.push_back(nullptr);
+    m_textures.push_back(texture);
+    return static_cast<std::uint32_t>(m_textures.size() - 1);
+}
+
+void SpriteBatch::flush(sf::RenderTarget& target, const sf::RenderStates& states)
+{
+    GAME_PROFILE_ZONE("SpriteBatch::flush");
+
+    m_stats = {};
+    m_stats.quads = m_quads.size();
+
+    // The submission index in the low bits makes every key unique, so plain sort is stable
+    std::sort(m_keys.begin(), m_keys.end());
+
+    m_vertices.resize(m_quads.size() * 6);
+    std::size_t runStart = 0;
+    std::uint32_t runTexture = 0;
+
+    auto submit = [&](std::size_t end) {
+        if (end == runStart) return;
+        sf::RenderStates runStates = states;
+        runStates.texture = runTexture < m_textures.size() ? m_textures[runTexture] : nullptr;
+        target.draw(&m_vertices[runStart], end - runStart, sf::PrimitiveType::Triangles, runStates);
+        ++m_stats.drawCalls;
+    };
+
+    for (std::size_t i = 0; i < m_keys.size(); ++i) {
+        std::uint32_t texture = static_cast<std::uint32_t>((m_keys[i] >> 32) & 0xFFFFFF);
+        if (i == 0) {
+            runTexture = texture;
+        } else if (texture != runTexture) {
+            // Layers only order quads; a layer change on the same texture doesn't need a new draw
+            submit(i * 6);
+            runStart = i * 6;
+            runTexture = texture;
+        }
+
+        const Quad& quad = m_quads[m_keys[i] & 0xFFFFFFFF];
+        sf::Vector2f texMin(quad.textureRect.position);
+        sf::Vector2f texMax = texMin + sf::Vector2f(quad.textureRect.size);
+        const sf::Vector2f texCoords[4] = {texMin, {texMax.x, texMin.y}, texMax, {texMin.x, texMax.y}};
+
+        sf::Vertex* v = &m_vertices[i * 6];
+        const int order[6] = {0, 1, 3, 3, 1, 2};
+        for (int k = 0; k < 6; ++k) {
+            v[k].position = quad.corners[order[k]];
+            v[k].texCoords = texCoords[order[k]];
+            v[k].color = quad.color;
+        }
+    }
+    submit(m_keys.size() * 6);
+
+    m_quads.clear();
+    m_keys.clear();
+    m_textures.clear();
+}
+
+} // namespace game::graphics
@@ -0,0 +1,58 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "TextureAtlas.hpp"
+
+namespace game::graphics {
+
+// Draw order between groups of quads; lower layers are drawn first
+enum class Layer : std::uint8_t {
+    Enemies,
+    Projectiles,
+    Player,
+    Weapons,
+};
+
+struct SpriteBatchStats {
+    std::size_t quads = 0;
+    std::size_t drawCalls = 0;
+};
+
+// Collects textured quads for a frame, sorts them by layer then texture and submits
+// one draw call per run of the same texture. Quads keep submission order within a run.
+class SpriteBatch {
+public:
+    // Axis-aligned quad covering `bounds`
+    void draw(Layer layer, const AtlasRegion& region, const sf::FloatRect& bounds,
+              const sf::Color& color = sf::Color::White);
+
+    // Quad of `size` with `origin` at `position`, rotated around the origin
+    void draw(Layer layer, const AtlasRegion& region, const sf::Vector2f& position, const sf::Vector2f& size,
+              const sf::Vector2f& origin, sf::Angle rotation, const sf::Color& color = sf::Color::White);
+
+    // Sort, draw everything queued since the last flush and clear the queue
+    void flush(sf::RenderTarget& target, const sf::RenderStates& states = sf::RenderStates::Default);
+
+    // Counts from the most recent flush()
+    const SpriteBatchStats& getStats() const { return m_stats; }
+
+private:
+    struct Quad {
+        std::array<sf::Vector2f, 4> corners;   // Top-left, top-right, bottom-right, bottom-left
+        sf::IntRect textureRect;
+        sf::Color color;
+    };
+
+    void push(Layer layer, const AtlasRegion& region, const std::array<sf::Vector2f, 4>& corners, const sf::Color& color);
+    std::uint32_t getTextureId(const sf::Texture* texture);
+
+    std::vector<Quad> m_quads;
+    std::vector<std::uint64_t> m_keys;             // Layer, texture id and submission index packed for sorting
+    std::vector<const sf::Texture*> m_textures;    // Texture id -> texture for this frame (0 is untextured)
+    sf::VertexArray m_vertices{sf::PrimitiveType::Triangles};
+    SpriteBatchStats m_stats;
+};
+
+} // namespace game::graphics
@@ -0,0 +1,109 @@
+#include "TextureAtlas.hpp"
+#include "../core/Log.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace game::graphics {
+
+void TextureAtlas::add(const std::string& name, const sf::Image& image)
+{
+    auto it = m_index.find(name);
+    if (it != m_index.end()) {
+        m_entries[it->second].image = image;
+    } else {
+        m_index[name] = m_entries.size();
+        m_entries.push_back({name, image, {}});
+    }
+    m_built = false;
+}
+
+bool TextureAtlas::build()
+{
+    m_built = false;
+    if (m_entries.empty()) return false;
+
+    // Tallest first keeps the shelves tight
+    std::vector<std::size_t> order(m_entries.size());
+    for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) {
+        return m_entries[a].image.getSize().y > m_entries[b].image.getSize().y;
+    });
+
+    // Start from a width that fits the widest image, grow until the shelves fit
+    const unsigned int maxSize = sf::Texture::getMaximumSize();
+    unsigned int width = 64;
+    for (const Entry& entry : m_entries) {
+        while (width < entry.image.getSize().x + Padding * 2) width *= 2;
+    }
+
+    unsigned int height = 0;
+    while (true) {
+        unsigned int x = Padding;
+        unsigned int y = Padding;
+        unsigned int shelfHeight = 0;
+        for (std::size_t i : order) {
+            sf::Vector2u size = m_entries[i].image.getSize();
+            if (x + size.x + Padding > width) {
+                x = Padding;
+                y += shelfHeight + Padding;
+                shelfHeight = 0;
+            }
+            m_entries[i].rect = sf::IntRect({static_cast<int>(x), static_cast<int>(y)},
+                                            {static_cast<int>(size.x), static_cast<int>(size.y)});
+            x += size.x + Padding;
+            shelfHeight = std::max(shelfHeight, size.y);
+        }
+        height = y + shelfHeight + Padding;
+
+        if (height <= width || width >= maxSize) break;
+        width *= 2;
+    }
+
+    if (width > maxSize || height > maxSize) {
+        GAME_LOG_ERROR("Texture atlas needs " << width << "x" << height << ", GPU limit is " << maxSize);
+        return false;
+    }
+
+    sf::Image packed({width, height}, sf::Color::Transparent);
+    for (const Entry& entry : m_entries) {
+        if (!packed.copy(entry.image, sf::Vector2u(entry.rect.position))) {
+            GAME_LOG_ERROR("Failed to copy " << entry.name << " into the texture atlas");
+            return false;
+        }
+    }
+
+    if (!m_texture.loadFromImage(packed)) {
+        GAME_LOG_ERROR("Failed to create texture atlas");
+        return false;
+    }
+
+    m_built = true;
+    GAME_LOG_INFO("Texture atlas built: " << m_entries.size() << " images in " << width << "x" << height);
+    return true;
+}
+
+AtlasRegion TextureAtlas::getRegion(const std::string& name) const
+{
+    auto it = m_index.find(name);
+    if (!m_built || it == m_index.end()) return {};
+    return {&m_texture, m_entries[it->second].rect};
+}
+
+sf::Image TextureAtlas::makeCircle(unsigned int diameter)
+{
+    sf::Image image({diameter, diameter}, sf::Color::Transparent);
+    const float radius = diameter / 2.f;
+
+    for (unsigned int y = 0; y < diameter; ++y) {
+        for (unsigned int x = 0; x < diameter; ++x) {
+            float dx = x + 0.5f - radius;
+            float dy = y + 0.5f - radius;
+            // One pixel of coverage falloff at the rim
+            float coverage = std::clamp(radius - std::sqrt(dx * dx + dy * dy), 0.f, 1.f);
+            image.setPixel({x, y}, sf::Color(255, 255, 255, static_cast<std::uint8_t>(coverage * 255.f)));
+        }
+    }
+    return image;
+}
+
+} // namespace game::graphics
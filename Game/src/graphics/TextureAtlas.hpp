@@ -0,0 +1,48 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace game::graphics {
+
+// A named rectangle inside an atlas texture
+struct AtlasRegion {
+    const sf::Texture* texture = nullptr;
+    sf::IntRect rect;
+};
+
+// Packs many small images into one texture at startup so everything drawn from it
+// can share a single draw call. Images are added first, then build() uploads once.
+class TextureAtlas {
+public:
+    // Replaces an image added earlier under the same name; takes effect on the next build()
+    void add(const std::string& name, const sf::Image& image);
+
+    // Shelf-packs every added image into one texture. Regions stay valid until the next build().
+    bool build();
+
+    // Region for `name`, or an empty region (null texture) if it was never added or built
+    AtlasRegion getRegion(const std::string& name) const;
+
+    const sf::Texture& getTexture() const { return m_texture; }
+
+    // White disc with a soft edge, for tinted circles
+    static sf::Image makeCircle(unsigned int diameter);
+
+private:
+    static constexpr unsigned int Padding = 2;   // Transparent gap so linear filtering doesn't bleed
+
+    struct Entry {
+        std::string name;
+        sf::Image image;
+        sf::IntRect rect;
+    };
+
+    std::vector<Entry> m_entries;
+    std::unordered_map<std::string, std::size_t> m_index;
+    sf::Texture m_texture;
+    bool m_built = false;
+};
+
+} // namespace game::graphics
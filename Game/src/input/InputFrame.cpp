@@ -0,0 +1,22 @@
+#include "InputFrame.hpp"
+#include <SFML/Window/Keyboard.hpp>
+
+namespace game::input {
+
+InputFrame sampleKeyboard()
+{
+    using Key = sf::Keyboard::Key;
+    auto held = [](Key a, Key b) { return sf::Keyboard::isKeyPressed(a) || sf::Keyboard::isKeyPressed(b); };
+
+    InputFrame frame;
+    if (held(Key::A, Key::Left))         frame.buttons |= MoveLeft;
+    if (held(Key::D, Key::Right))        frame.buttons |= MoveRight;
+    if (held(Key::W, Key::Up))           frame.buttons |= MoveUp;
+    if (held(Key::S, Key::Down))         frame.buttons |= MoveDown;
+    if (held(Key::Space, Key::LControl)) frame.buttons |= Attack;
+    if (sf::Keyboard::isKeyPressed(Key::H)) frame.buttons |= Heal;
+    if (sf::Keyboard::isKeyPressed(Key::J)) frame.buttons |= Damage;
+    return frame;
+}
+
+} // namespace game::input
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+
+namespace game::input {
+
+enum InputButton : std::uint32_t {
+    MoveLeft  = 1u << 0,
+    MoveRight = 1u << 1,
+    MoveUp    = 1u << 2,
+    MoveDown  = 1u << 3,
+    Attack    = 1u << 4,
+    Heal      = 1u << 5,   // Debug
+    Damage    = 1u << 6,   // Debug
+};
+
+// Buttons held during one simulation step
+struct InputFrame {
+    std::uint32_t buttons = 0;
+
+    bool isDown(InputButton button) const { return (buttons & button) != 0; }
+};
+
+// Real-time keyboard state (needs a window system)
+InputFrame sampleKeyboard();
+
+} // namespace game::input
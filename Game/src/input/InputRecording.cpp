@@ -0,0 +1,160 @@
+#include "InputRecording.hpp"
+#include "../core/Log.hpp"
+#include <cstddef>
+#include <cstring>
+
+namespace game::input {
+
+namespace {
+
+const char Magic[4] = {'G', 'I', 'N', 'P'};
+constexpr std::uint32_t Version = 1;
+
+#pragma pack(push, 1)
+struct RecordingHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t worldWidth;
+    std::uint32_t worldHeight;
+    std::uint64_t seed;
+    std::uint32_t tickRate;
+    std::uint32_t enemyCount;
+    std::uint32_t frameCount;
+    std::uint32_t reserved;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(RecordingHeader) == 40, "Recording header layout must not change");
+
+} // namespace
+
+InputRecorder::~InputRecorder()
+{
+    close();
+}
+
+bool InputRecorder::open(const std::string& path, const RecordingInfo& info)
+{
+    close();
+
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_file) {
+        GAME_LOG_ERROR("Failed to create input recording: " << path);
+        return false;
+    }
+
+    RecordingHeader header{};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.worldWidth = info.worldWidth;
+    header.worldHeight = info.worldHeight;
+    header.seed = info.seed;
+    header.tickRate = info.tickRate;
+    header.enemyCount = info.enemyCount;
+    header.frameCount = 0;   // Patched in close()
+    m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    m_path = path;
+    m_frameCount = 0;
+    m_runLength = 0;
+    return true;
+}
+
+void InputRecorder::record(const InputFrame& frame)
+{
+    if (!m_file.is_open()) return;
+
+    if (m_runLength > 0 && frame.buttons != m_runButtons) {
+        flushRun();
+    }
+    m_runButtons = frame.buttons;
+    ++m_runLength;
+    ++m_frameCount;
+}
+
+void InputRecorder::flushRun()
+{
+    if (m_runLength == 0) return;
+
+    m_file.write(reinterpret_cast<const char*>(&m_runLength), sizeof(m_runLength));
+    m_file.write(reinterpret_cast<const char*>(&m_runButtons), sizeof(m_runButtons));
+    m_runLength = 0;
+}
+
+bool InputRecorder::close()
+{
+    if (!m_file.is_open()) return true;
+
+    flushRun();
+    m_file.seekp(offsetof(RecordingHeader, frameCount));
+    m_file.write(reinterpret_cast<const char*>(&m_frameCount), sizeof(m_frameCount));
+
+    bool ok = static_cast<bool>(m_file);
+    m_file.close();
+
+    if (!ok) {
+        GAME_LOG_ERROR("Failed to write input recording: " << m_path);
+        return false;
+    }
+
+    GAME_LOG_INFO("Input recorded: " << m_path << " (" << m_frameCount << " frames)");
+    return true;
+}
+
+bool InputReplay::load(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    RecordingHeader header{};
+    if (!file || !file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        GAME_LOG_ERROR("Failed to open input recording: " << path);
+        return false;
+    }
+
+    if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version) {
+        GAME_LOG_ERROR("Not a supported input recording (version " << header.version << "): " << path);
+        return false;
+    }
+
+    m_info.worldWidth = header.worldWidth;
+    m_info.worldHeight = header.worldHeight;
+    m_info.seed = header.seed;
+    m_info.tickRate = header.tickRate;
+    m_info.enemyCount = header.enemyCount;
+    m_frameCount = header.frameCount;
+
+    m_runs.clear();
+    std::uint32_t covered = 0;
+    Run run;
+    while (covered < m_frameCount && file.read(reinterpret_cast<char*>(&run), sizeof(run))) {
+        m_runs.push_back(run);
+        covered += run.count;
+    }
+
+    if (covered != m_frameCount) {
+        GAME_LOG_ERROR("Input recording is truncated: " << path);
+        return false;
+    }
+
+    m_run = 0;
+    m_playedInRun = 0;
+    m_framesPlayed = 0;
+    GAME_LOG_INFO("Input replay loaded: " << path << " (" << m_frameCount << " frames)");
+    return true;
+}
+
+bool InputReplay::next(InputFrame& frame)
+{
+    // Skip empty runs so a bad file cannot stall playback
+    while (m_run < m_runs.size() && m_playedInRun >= m_runs[m_run].count) {
+        ++m_run;
+        m_playedInRun = 0;
+    }
+    if (m_run >= m_runs.size()) return false;
+
+    frame.buttons = m_runs[m_run].buttons;
+    ++m_playedInRun;
+    ++m_framesPlayed;
+    return true;
+}
+
+} // namespace game::input
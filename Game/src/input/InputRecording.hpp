@@ -0,0 +1,72 @@
+#pragma once
+#include "InputFrame.hpp"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace game::input {
+
+// What a recording needs to be replayed against the same world
+struct RecordingInfo {
+    std::uint32_t worldWidth = 0;    // Tiles
+    std::uint32_t worldHeight = 0;
+    std::uint64_t seed = 0;          // World and simulation seed
+    std::uint32_t tickRate = 120;    // Steps per second the frames were sampled at
+    std::uint32_t enemyCount = 0;    // 0 = the game's starting enemies, otherwise a headless stress run
+};
+
+// Input file layout (little-endian):
+//   "GINP", u32 version, u32 worldWidth, u32 worldHeight, u64 seed, u32 tickRate, u32 enemyCount,
+//   u32 frameCount, u32 reserved, then runs of (u32 count, u32 buttons) until frameCount frames are covered.
+// Held buttons rarely change between steps, so runs keep files small.
+
+// Appends one frame per simulation step and writes the file on close()
+class InputRecorder {
+public:
+    ~InputRecorder();
+
+    bool open(const std::string& path, const RecordingInfo& info);
+    void record(const InputFrame& frame);
+    bool close();
+
+    bool isOpen() const { return m_file.is_open(); }
+    std::uint32_t getFrameCount() const { return m_frameCount; }
+
+private:
+    void flushRun();
+
+    std::ofstream m_file;
+    std::string m_path;
+    std::uint32_t m_frameCount = 0;
+    std::uint32_t m_runButtons = 0;
+    std::uint32_t m_runLength = 0;
+};
+
+// Hands recorded frames back one simulation step at a time
+class InputReplay {
+public:
+    bool load(const std::string& path);
+
+    // False once every frame has been played
+    bool next(InputFrame& frame);
+
+    const RecordingInfo& getInfo() const { return m_info; }
+    std::uint32_t getFrameCount() const { return m_frameCount; }
+    bool isFinished() const { return m_framesPlayed >= m_frameCount; }
+
+private:
+    struct Run {
+        std::uint32_t count;
+        std::uint32_t buttons;
+    };
+
+    RecordingInfo m_info;
+    std::uint32_t m_frameCount = 0;
+    std::vector<Run> m_runs;
+    std::size_t m_run = 0;
+    std::uint32_t m_playedInRun = 0;
+    std::uint32_t m_framesPlayed = 0;
+};
+
+} // namespace game::input
@@ -0,0 +1,33 @@
+#include "ScriptedInput.hpp"
+
+namespace game::input {
+
+ScriptedInput::ScriptedInput(std::uint64_t seed)
+    : m_rng(seed)
+{
+}
+
+InputFrame ScriptedInput::next()
+{
+    if (m_ticksLeft == 0) {
+        // New direction (possibly diagonal, possibly standing still) for 0.25 - 2 s at 120 Hz
+        static const std::uint32_t directions[] = {
+            0, MoveLeft, MoveRight, MoveUp, MoveDown,
+            MoveLeft | MoveUp, MoveLeft | MoveDown, MoveRight | MoveUp, MoveRight | MoveDown
+        };
+        m_heldButtons = directions[m_rng() % (sizeof(directions) / sizeof(directions[0]))];
+        m_ticksLeft = 30 + static_cast<unsigned int>(m_rng() % 211);
+    }
+    --m_ticksLeft;
+
+    InputFrame frame;
+    frame.buttons = m_heldButtons;
+
+    // Tap attack roughly twice a second
+    if (m_rng() % 60 == 0) {
+        frame.buttons |= Attack;
+    }
+    return frame;
+}
+
+} // namespace game::input
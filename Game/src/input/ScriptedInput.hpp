@@ -0,0 +1,22 @@
+#pragma once
+#include "InputFrame.hpp"
+#include <cstdint>
+#include <random>
+
+namespace game::input {
+
+// Deterministic stand-in for a player: holds a random direction for a while,
+// swinging the sword now and then. The same seed always yields the same frames.
+class ScriptedInput {
+public:
+    explicit ScriptedInput(std::uint64_t seed);
+
+    InputFrame next();
+
+private:
+    std::mt19937_64 m_rng;
+    std::uint32_t m_heldButtons = 0;
+    unsigned int m_ticksLeft = 0;
+};
+
+} // namespace game::input
@@ -4,12 +4,29 @@
 #include <memory>
 #include <string>
 #include <cstdlib>
+#include <filesystem>
 #include <vector>
 #include "player/Player.hpp"
-#include "entities/enemies/Octorok.hpp"
+#include "projectiles/ProjectilePool.hpp"
+#include "ecs/Systems.hpp"
+#include "graphics/SpriteBatch.hpp"
+#include "graphics/TextureAtlas.hpp"
+#include "assets/AssetManager.hpp"
+#include "core/FixedTimestep.hpp"
+#include "core/Log.hpp"
+#include "core/Profiler.hpp"
+#include "core/ProfilerOverlay.hpp"
+#include "input/InputFrame.hpp"
+#include "input/InputRecording.hpp"
+#include "sim/Headless.hpp"
+#include "sim/Simulation.hpp"
+#include "ui/Hud.hpp"
 #include "world/World.hpp"
 #include "world/Camera.hpp"
+#include "audio/SoundBank.hpp"
 #include "audio/SoundManager.hpp"
+#include "audio/VoiceCapture.hpp"
+#include "audio/VoiceLoopback.hpp"
 
 // Helper: wire up all sound callbacks for a player instance
 static void connectPlayerSounds(game::player::Player& player, game::audio::SoundManager& soundManager)
@@ -37,11 +54,65 @@ static void connectPlayerSounds(game::player::Player& player, game::audio::Sound
     });
 }
 
-int main()
+// Helper: swap between the exploration and battle themes as enemies close in. The battle theme
+// is prefetched while enemies are still on their way so the crossfade starts on time.
+static void updateCombatMusic(const game::ecs::Registry& registry, const sf::Vector2f& playerPosition,
+                              game::audio::SoundManager& soundManager, bool& inCombat)
 {
-    const char* displayEnv = std::getenv("DISPLAY");
+    const float prefetchRadius = 500.f;
+    const float enterRadius = 250.f;
+    const float leaveRadius = 400.f;   // Wider than enterRadius so the music doesn't flap at the edge
+
+    float nearest = prefetchRadius * prefetchRadius + 1.f;
+    for (const auto& transform : registry.storage<game::ecs::Transform>().components()) {
+        sf::Vector2f offset = transform.position - playerPosition;
+        nearest = std::min(nearest, offset.x * offset.x + offset.y * offset.y);
+    }
+
+    if (!inCombat) {
+        if (nearest <= enterRadius * enterRadius) {
+            inCombat = true;
+            soundManager.crossfadeMusic(game::audio::Music::BattleTheme, sf::seconds(1.5f));
+        } else if (nearest <= prefetchRadius * prefetchRadius) {
+            soundManager.prefetchMusic(game::audio::Music::BattleTheme);
+        }
+    } else if (nearest > leaveRadius * leaveRadius) {
+        inCombat = false;
+        soundManager.crossfadeMusic(game::audio::Music::MainTheme, sf::seconds(3.f));
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Without a display (build servers, CI) run the simulation headless and report timings
+    bool headless = !std::getenv("DISPLAY");
+    std::string recordPath;
+    std::string replayPath;
+    std::string voiceFilePath;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--headless") headless = true;
+        else if (arg == "--record" && i + 1 < argc) recordPath = argv[++i];
+        else if (arg == "--replay" && i + 1 < argc) replayPath = argv[++i];
+        else if (arg == "--voice-file" && i + 1 < argc) voiceFilePath = argv[++i];
+    }
+    if (headless) {
+        game::sim::HeadlessOptions options;
+        if (!game::sim::parseHeadlessOptions(argc, argv, options)) {
+            std::cerr << "Usage: game [--headless] [--world WxH] [--enemies N] [--ticks N] [--seed N]"
+                         " [--record FILE] [--replay FILE]\n";
+            return 1;
+        }
+        return game::sim::runHeadless(options);
+    }
+    
+    // Every file goes through the asset cache. Textures are requested up front so they decode
+    // on worker threads while the world is generated; World::loadTileset etc. pick them up later.
+    game::assets::AssetManager assets;
+    assets.loadTexture("assets/backgrounds/grass_bg.png");
+    assets.loadTexture("assets/tilesets/terrain.png");
     
-    sf::Font font;
+    game::assets::FontHandle font;
     std::unique_ptr<sf::Text> fpsText;
     std::string loadedFontPath;
     std::vector<std::string> fontCandidates = {
@@ -54,73 +125,137 @@ int main()
     
     bool fontLoaded = false;
     for (auto &p : fontCandidates) {
-        if (font.openFromFile(p)) {
-            fpsText = std::make_unique<sf::Text>(font, "", 16u);
+        if (!std::filesystem::exists(p)) continue;
+        font = assets.loadFont(p);
+        assets.finish(font);
+        if (font.isReady()) {
+            fpsText = std::make_unique<sf::Text>(*font, "", 16u);
             fpsText->setFillColor(sf::Color::White);
             fpsText->setPosition({8.f, 8.f});
             loadedFontPath = p;
             fontLoaded = true;
-            std::cout << "Font loaded from " << p << "\n";
+            GAME_LOG_INFO("Font loaded from " << p);
             break;
         }
     }
     
     // CREATE SOUND MANAGER
-    game::audio::SoundManager soundManager;
+    game::audio::SoundManager soundManager(assets);
     
-    // Load sound effects
-    soundManager.loadSound(game::audio::SoundEffect::PlayerWalk,   "assets/sounds/walk.wav");
-    soundManager.loadSound(game::audio::SoundEffect::PlayerAttack, "assets/sounds/sword_attack.wav");
-    soundManager.loadSound(game::audio::SoundEffect::PlayerHit,    "assets/sounds/hit.wav");
-    soundManager.loadSound(game::audio::SoundEffect::EnemyHit,     "assets/sounds/enemy_hit.wav");
-    soundManager.loadSound(game::audio::SoundEffect::EnemyDeath,   "assets/sounds/enemy_death.wav");
-    soundManager.loadSound(game::audio::SoundEffect::GameOver,     "assets/sounds/game_over.wav");
+    // Load sound effects from one packed bank, rebuilding it from the loose files whenever one changes.
+    // Short gameplay effects are stored as mono at a lower rate; nobody hears the difference.
+    const std::string soundBankPath = "assets/sounds/effects.gsfx";
+    const std::vector<game::audio::SoundBankSource> soundSources = {   // In SoundEffect order
+        {game::audio::getSoundEffectName(game::audio::SoundEffect::PlayerWalk),   "assets/sounds/walk.wav",         22050, true},
+        {game::audio::getSoundEffectName(game::audio::SoundEffect::PlayerAttack), "assets/sounds/sword_attack.wav", 22050, true},
+        {game::audio::getSoundEffectName(game::audio::SoundEffect::PlayerHit),    "assets/sounds/hit.wav",          22050, true},
+        {game::audio::getSoundEffectName(game::audio::SoundEffect::EnemyHit),     "assets/sounds/enemy_hit.wav",    22050, true},
+        {game::audio::getSoundEffectName(game::audio::SoundEffect::EnemyDeath),   "assets/sounds/enemy_death.wav",  22050, true},
+        {game::audio::getSoundEffectName(game::audio::SoundEffect::GameOver),     "assets/sounds/game_over.wav",    0,     false},
+    };
+    if (!game::audio::SoundBank::isUpToDate(soundBankPath, soundSources)) {
+        game::audio::SoundBank::write(soundBankPath, soundSources);
+    }
+    soundManager.loadSoundBank(soundBankPath);
+    // Whatever the bank lacks (all of it, if it couldn't be opened) loads from the loose file
+    for (std::size_t i = 0; i < game::audio::SoundEffectCount; ++i) {
+        auto effect = static_cast<game::audio::SoundEffect>(i);
+        if (!soundManager.hasSound(effect)) {
+            soundManager.loadSound(effect, soundSources[i].path);
+        }
+    }
     
-    // Load and start background music
+    // Load and start background music (starts once it has been opened)
     soundManager.loadMusic(game::audio::Music::MainTheme, "assets/music/background.ogg");
+    soundManager.loadMusic(game::audio::Music::BattleTheme, "assets/music/battle.ogg");
     soundManager.playMusic(game::audio::Music::MainTheme, true, 30.f);
     
+    // Push-to-talk (hold V). The microphone, or --voice-file standing in for it, is opened
+    // on first use and then left running; for now the voice is monitored through a loopback.
+    game::audio::VoiceCapture voice;
+    game::audio::VoiceLoopback voiceMonitor(voice);
+    bool voiceUnavailable = false;
+    
     game::player::Player player;
-    player.load("assets/sprites/link_64x64_spritesheet.png", {16, 16}, 4);
+    player.load(assets, "assets/sprites/link_64x64_spritesheet.png", {16, 16}, 4);
     connectPlayerSounds(player, soundManager);
     
-    if (!displayEnv) {
-        std::cout << "No DISPLAY detected\n";
-        return 0;
-    }
-    
     sf::RenderWindow window(sf::VideoMode({800u, 600u}), "Game - Open World");
     window.setVerticalSyncEnabled(true);
     
-    // Create world (50x50 tiles, each 32px)
-    game::world::World world(50, 50, 32.f);
-    world.generate();
-    world.loadBackgroundTexture("assets/backgrounds/grass_bg.png");
-    world.loadTileset("assets/tilesets/terrain.png", {32, 32});
+    // All entity art lives in one texture so the whole entity set goes out in a single draw call
+    game::graphics::TextureAtlas atlas;
+    atlas.add("circle", game::graphics::TextureAtlas::makeCircle(64));
+    player.addArt(atlas);
+    atlas.build();
+    game::graphics::SpriteBatch spriteBatch;
+    
+    // Input replay (--replay) and recording (--record); frames are fed to the simulation once per step
+    game::input::InputReplay replay;
+    bool replaying = !replayPath.empty() && replay.load(replayPath);
+    if (replaying && replay.getInfo().enemyCount != 0) {
+        std::cerr << "Recording comes from a headless stress run; replay it with --headless\n";
+        replaying = false;
+    }
+    game::input::InputRecorder recorder;
+    
+    // Create world (50x50 tiles, each 32px), or pick up the last one saved with F5.
+    // Recorded and replayed games always start from a freshly generated world so they line up.
+    const std::string mapPath = "world.gmap";
+    game::world::World world(replaying ? replay.getInfo().worldWidth : 50,
+                             replaying ? replay.getInfo().worldHeight : 50, 32.f);
+    if (replaying) {
+        world.setSeed(replay.getInfo().seed);
+        world.generate();
+    } else if (!recordPath.empty() || !std::filesystem::exists(mapPath) || !world.load(mapPath)) {
+        world.generate();
+    }
+    world.loadBackgroundTexture(assets, "assets/backgrounds/grass_bg.png");
+    world.loadTileset(assets, "assets/tilesets/terrain.png", {32, 32});
+    
+    // Every projectile in flight, whoever fired it
+    game::projectiles::ProjectilePool projectiles;
     
     // Create camera
     game::world::Camera camera(sf::Vector2f(800.f, 600.f), world.getWorldBounds());
     
     sf::Clock clock;
     
+    // Gameplay advances in fixed 120 Hz steps; rendering interpolates between the last two
+    game::core::FixedTimestep timestep(sf::seconds(1.f / 120.f));
+    
+    if (!recordPath.empty()) {
+        game::input::RecordingInfo info;
+        info.worldWidth = 50;
+        info.worldHeight = 50;
+        info.seed = world.getSeed();
+        info.tickRate = 120;
+        recorder.open(recordPath, info);
+    }
+    
     // Spawn player in center of world
     sf::Vector2f worldCenter(
         world.getWorldBounds().size.x / 2.f,
         world.getWorldBounds().size.y / 2.f
     );
-    player.setPosition(worldCenter);
+    player.teleport(worldCenter);
     
     // CREATE ENEMIES scattered around the world
-    std::vector<std::shared_ptr<game::enemies::Octorok>> enemies;
-    auto spawnEnemies = [&enemies]() {
-        enemies.clear();
-        enemies.push_back(std::make_shared<game::enemies::Octorok>(sf::Vector2f{ 400.f, 300.f}));
-        enemies.push_back(std::make_shared<game::enemies::Octorok>(sf::Vector2f{ 600.f, 400.f}));
-        enemies.push_back(std::make_shared<game::enemies::Octorok>(sf::Vector2f{ 800.f, 500.f}));
-        enemies.push_back(std::make_shared<game::enemies::Octorok>(sf::Vector2f{ 300.f, 600.f}));
-        enemies.push_back(std::make_shared<game::enemies::Octorok>(sf::Vector2f{1000.f, 400.f}));
+    game::ecs::Registry registry;
+    auto spawnEnemies = [&registry, &projectiles]() {
+        registry.clear();
+        projectiles.clear();
+        game::sim::spawnStartingEnemies(registry);
     };
     spawnEnemies();
+    
+    game::sim::Simulation simulation(world, player, registry, projectiles, world.getSeed());
+    simulation.setOnEnemyHitCallback([&soundManager](const sf::Vector2f& position, bool killed) {
+        soundManager.playSound(game::audio::SoundEffect::EnemyHit, position, 25.f);
+        if (killed) {
+            soundManager.playSound(game::audio::SoundEffect::EnemyDeath, position, 70.f);
+        }
+    });
 
     // Game Over screen
     sf::RectangleShape gameOverOverlay({800.f, 600.f});
@@ -129,9 +264,10 @@ int main()
     std::unique_ptr<sf::Text> gameOverText;
     std::unique_ptr<sf::Text> tryAgainText;
     bool gameOver = false;
+    bool inCombat = false;
     
     if (fontLoaded) {
-        gameOverText = std::make_unique<sf::Text>(font, "GAME OVER", 72u);
+        gameOverText = std::make_unique<sf::Text>(*font, "GAME OVER", 72u);
         gameOverText->setFillColor(sf::Color::Red);
         gameOverText->setOutlineColor(sf::Color::White);
         gameOverText->setOutlineThickness(3.f);
@@ -140,7 +276,7 @@ int main()
         gameOverText->setOrigin({bounds.size.x / 2.f, bounds.size.y / 2.f});
         gameOverText->setPosition({400.f, 250.f});
         
-        tryAgainText = std::make_unique<sf::Text>(font, "Press SPACE to Try Again", 30u);
+        tryAgainText = std::make_unique<sf::Text>(*font, "Press SPACE to Try Again", 30u);
         tryAgainText->setFillColor(sf::Color::Yellow);
         tryAgainText->setOutlineColor(sf::Color::Black);
         tryAgainText->setOutlineThickness(2.f);
@@ -150,11 +286,20 @@ int main()
         tryAgainText->setPosition({400.f, 350.f});
     }
     
+    // Zone timings (F3 to show, F4 to dump a Chrome trace)
+    game::core::Profiler& profiler = game::core::Profiler::instance();
+    game::ui::Hud hud;
+    std::unique_ptr<game::core::ProfilerOverlay> profilerOverlay;
+    if (fontLoaded) {
+        profilerOverlay = std::make_unique<game::core::ProfilerOverlay>(*font);
+    }
+    
     while (window.isOpen())
     {
-        sf::Time dt = clock.restart();
+        sf::Time frameTime = clock.restart();
         
         // Update sound manager (cleans up finished one-shot sounds)
+        assets.update();
         soundManager.update();
         
         while (const auto ev = window.pollEvent())
@@ -166,15 +311,25 @@ int main()
             {
                 if (key->code == sf::Keyboard::Key::Escape)
                     window.close();
+                
+                if (key->code == sf::Keyboard::Key::F5)
+                    world.save(mapPath);
+                
+                if (key->code == sf::Keyboard::Key::F3 && profilerOverlay)
+                    profilerOverlay->toggle();
+                
+                if (key->code == sf::Keyboard::Key::F4)
+                    profiler.writeChromeTrace("profile.json");
                     
                 if (gameOver && key->code == sf::Keyboard::Key::Space) {
                     gameOver = false;
+                    inCombat = false;
                     
                     soundManager.playMusic(game::audio::Music::MainTheme, true, 30.f);
                     
                     player = game::player::Player();
-                    player.load("assets/sprites/link_64x64_spritesheet.png", {16, 16}, 4);
-                    player.setPosition(worldCenter);
+                    player.load(assets, "assets/sprites/link_64x64_spritesheet.png", {16, 16}, 4);
+                    player.teleport(worldCenter);
                     connectPlayerSounds(player, soundManager);
 
                     spawnEnemies();
@@ -182,66 +337,61 @@ int main()
             }
         }
         
-        if (!player.isAlive() && !gameOver) {
-            gameOver = true;
-            std::cout << "=== GAME OVER ===\n";
+        bool talking = window.hasFocus() && sf::Keyboard::isKeyPressed(sf::Keyboard::Key::V);
+        if (talking && !voice.isCapturing() && !voiceUnavailable) {
+            bool started = voiceFilePath.empty() ? voice.startDevice() : voice.startFile(voiceFilePath);
+            if (started) voiceMonitor.start();
+            voiceUnavailable = !started;   // Don't retry every frame while the key is held
         }
+        voice.setTransmitting(talking && voice.isCapturing());
         
-        if (!gameOver) {
-            player.handleInput();
-            player.update(dt);
+        timestep.advance(frameTime);
+        while (timestep.step()) {
+            const sf::Time dt = timestep.getStep();
             
-            // Check world collision before committing movement
-            sf::FloatRect playerBounds = player.getBounds();
-            playerBounds.position = player.getPendingPosition() - sf::Vector2f(playerBounds.size.x / 2.f, playerBounds.size.y / 2.f);
+            if (gameOver) continue;
             
-            if (!world.checkCollision(playerBounds)) {
-                player.commitPosition();
+            if (!player.isAlive()) {
+                gameOver = true;
+                GAME_LOG_INFO("=== GAME OVER ===");
+                recorder.close();   // A recording covers one life
+                continue;
             }
             
-            camera.update(player.getPosition());
-            
-            sf::FloatRect swordBounds = player.getSwordBounds();
-            
-            for (auto& enemy : enemies) {
-                if (enemy->isAlive()) {
-                    enemy->updateAI(player.getPosition());
-                    enemy->update(dt);
-                    
-                    if (player.isAttacking() && 
-                        swordBounds.findIntersection(enemy->getBounds()).has_value()) {
-                        enemy->takeDamage(1.f);
-                        soundManager.playSound(game::audio::SoundEffect::EnemyHit, 25.f);
-                        
-                        if (!enemy->isAlive()) {
-                            soundManager.playSound(game::audio::SoundEffect::EnemyDeath, 70.f);
-                        }
-                    }
-                    
-                    auto& projectiles = enemy->getProjectiles();
-                    for (auto& projectile : projectiles) {
-                        if (projectile->isAlive() && 
-                            player.checkCollision(projectile->getShape())) {
-                            projectile->markForDeletion();
-                            player.takeDamage(0.5f);
-                        }
-                    }
-                }
+            game::input::InputFrame input;
+            if (!replaying || !replay.next(input)) {
+                input = game::input::sampleKeyboard();
             }
+            recorder.record(input);
             
-            // Remove dead enemies
-            enemies.erase(
-                std::remove_if(enemies.begin(), enemies.end(),
-                    [](const auto& e) { return !e->isAlive(); }),
-                enemies.end()
-            );
+            simulation.step(input, dt);
+            camera.update(player.getPosition(), dt);
+        }
+        
+        // Render state sits between the last two simulation steps
+        const float alpha = timestep.getAlpha();
+        camera.interpolate(alpha);
+        soundManager.setListenerPosition(camera.getPosition());
+        if (!gameOver) {
+            world.updateStreaming(camera.getViewBounds());
+            updateCombatMusic(registry, player.getPosition(), soundManager, inCombat);
         }
         
         if (fpsText) {
-            float fps = 1.f / std::max(1e-6f, dt.asSeconds());
-            fpsText->setString("FPS: " + std::to_string(static_cast<int>(fps + 0.5f)));
+            float fps = 1.f / std::max(1e-6f, frameTime.asSeconds());
+            const game::graphics::SpriteBatchStats& batchStats = spriteBatch.getStats();
+            fpsText->setString("FPS: " + std::to_string(static_cast<int>(fps + 0.5f)) +
+                               "  Sprites: " + std::to_string(batchStats.quads) +
+                               "  Draw calls: " + std::to_string(batchStats.drawCalls) +
+                               (voice.isTransmitting()
+                                    ? "  Voice: " + std::to_string(static_cast<int>(voiceMonitor.getLatencyMs() + 0.5f)) + " ms"
+                                    : std::string()));
         }
         
+        profiler.endFrame();
+        if (profilerOverlay) profilerOverlay->update(profiler);
+        hud.update(player);
+        
         window.clear(sf::Color::Black);
         
         if (gameOver) {
@@ -252,19 +402,21 @@ int main()
                 window.draw(*tryAgainText);
             }
         } else {
+            GAME_PROFILE_ZONE("Render");
+            
             camera.apply(window);
             world.draw(window, camera.getViewBounds());
             
-            for (const auto& enemy : enemies) {
-                if (enemy->isAlive()) {
-                    enemy->draw(window);
-                }
-            }
-            
-            player.draw(window);
+            game::graphics::AtlasRegion circle = atlas.getRegion("circle");
+            game::ecs::drawEntities(registry, spriteBatch, circle, camera.getViewBounds(), alpha);
+            projectiles.draw(spriteBatch, circle, camera.getViewBounds(), alpha);
+            player.draw(spriteBatch, atlas, alpha);
+            spriteBatch.flush(window);
             
             window.setView(window.getDefaultView());
+            hud.draw(window);
             if (fpsText) window.draw(*fpsText);
+            if (profilerOverlay) profilerOverlay->draw(window);
         }
         
         window.display();
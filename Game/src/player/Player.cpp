@@ -1,21 +1,27 @@
 #include "Player.hpp"
-#include <SFML/Window/Keyboard.hpp>
-#include <iostream>
+#include "../assets/AssetManager.hpp"
+#include "../core/Profiler.hpp"
+#include "../core/Log.hpp"
+#include "../graphics/SpriteBatch.hpp"
+#include <algorithm>
 #include <cmath>
 
 namespace game::player {
 
-Player::Player()
-    : m_sprite(m_texture)
-{}
+Player::Player() = default;
 
-bool Player::load(const std::string& texturePath, const sf::Vector2i& frameSize, unsigned int framesPerRow)
+bool Player::load(game::assets::AssetManager& assets, const std::string& texturePath,
+                  const sf::Vector2i& frameSize, unsigned int framesPerRow)
 {
     m_frameSize = frameSize;
     m_framesPerRow = framesPerRow;
 
-    if (!m_texture.loadFromFile(texturePath)) {
-        std::cerr << "Failed to load image: " << texturePath << " — generating placeholder spritesheet.\n";
+    game::assets::ImageHandle sheet = assets.loadImage(texturePath);
+    assets.finish(sheet);
+    if (sheet.isReady()) {
+        m_sheet = *sheet;
+    } else {
+        GAME_LOG_WARN("Generating placeholder spritesheet for " << texturePath);
 
         unsigned int rows = 4;
         unsigned int w = m_framesPerRow * static_cast<unsigned int>(m_frameSize.x);
@@ -46,20 +52,15 @@ bool Player::load(const std::string& texturePath, const sf::Vector2i& frameSize,
             }
         }
 
-        if (!m_texture.loadFromImage(image)) {
-            std::cerr << "Failed to create placeholder texture\n";
-            return false;
-        }
+        m_sheet = std::move(image);
     }
 
-    m_sprite.setTexture(m_texture);
-    m_sprite.setTextureRect(sf::IntRect({0,0}, {m_frameSize.x, m_frameSize.y}));
-    m_sprite.setOrigin(sf::Vector2f(0.f, 0.f));
+    m_frameRect = sf::IntRect({0,0}, {m_frameSize.x, m_frameSize.y});
     
-    sf::Vector2u texSize = m_texture.getSize();
-    std::cout << "Texture loaded: " << texturePath << " Size: " << texSize.x << "x" << texSize.y 
-              << " Frame size: " << m_frameSize.x << "x" << m_frameSize.y 
-              << " Frames per row: " << m_framesPerRow << "\n";
+    sf::Vector2u texSize = m_sheet.getSize();
+    GAME_LOG_INFO("Texture loaded: " << texturePath << " Size: " << texSize.x << "x" << texSize.y 
+                  << " Frame size: " << m_frameSize.x << "x" << m_frameSize.y 
+                  << " Frames per row: " << m_framesPerRow);
     
     return true;
 }
@@ -67,18 +68,25 @@ bool Player::load(const std::string& texturePath, const sf::Vector2i& frameSize,
 void Player::setPosition(const sf::Vector2f& pos)
 {
     m_position = pos;
-    m_sprite.setPosition(m_position);
+}
+
+void Player::teleport(const sf::Vector2f& pos)
+{
+    setPosition(pos);
+    m_previousPosition = pos;
 }
 
 sf::Vector2f Player::getPosition() const { return m_position; }
 
 bool Player::checkCollision(const sf::CircleShape& circle) const
 {
-    sf::FloatRect playerRect = getBounds();
-    
-    sf::Vector2f circlePos = circle.getPosition();
     float radius = circle.getRadius();
-    sf::Vector2f circleCenter = circlePos + sf::Vector2f(radius, radius);
+    return checkCollision(circle.getPosition() + sf::Vector2f(radius, radius), radius);
+}
+
+bool Player::checkCollision(const sf::Vector2f& circleCenter, float radius) const
+{
+    sf::FloatRect playerRect = getBounds();
     
     float rectLeft   = playerRect.position.x;
     float rectTop    = playerRect.position.y;
@@ -98,7 +106,7 @@ bool Player::checkCollision(const sf::CircleShape& circle) const
 void Player::takeDamage(float amount)
 {
     m_health = std::max(0.f, m_health - amount);
-    std::cout << "Player took " << amount << " damage! Health: " << m_health << "/" << m_maxHealth << "\n";
+    GAME_LOG_DEBUG("Player took " << amount << " damage! Health: " << m_health << "/" << m_maxHealth);
     
     if (m_onHitCallback) {
         m_onHitCallback();
@@ -108,7 +116,7 @@ void Player::takeDamage(float amount)
     m_invincibilityTimer = sf::Time::Zero;
     
     if (m_health <= 0.f) {
-        std::cout << "Player died!\n";
+        GAME_LOG_DEBUG("Player died!");
 
         // Stop walk sound if we were moving when we died
         if (m_isMoving) {
@@ -127,19 +135,22 @@ void Player::heal(float amount)
     m_health = std::min(m_maxHealth, m_health + amount);
 }
 
-void Player::handleInput()
+void Player::handleInput(const game::input::InputFrame& input)
 {
+    using game::input::InputButton;
+    m_input = input;
+    
     sf::Vector2f dir{0.f, 0.f};
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A)    || sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Left))  dir.x -= 1.f;
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D)    || sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Right)) dir.x += 1.f;
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::W)    || sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Up))    dir.y -= 1.f;
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::S)    || sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Down))  dir.y += 1.f;
+    if (input.isDown(InputButton::MoveLeft))  dir.x -= 1.f;
+    if (input.isDown(InputButton::MoveRight)) dir.x += 1.f;
+    if (input.isDown(InputButton::MoveUp))    dir.y -= 1.f;
+    if (input.isDown(InputButton::MoveDown))  dir.y += 1.f;
 
     if (dir.x != 0.f || dir.y != 0.f) {
         m_lastDirection = dir;
     }
 
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Space) || sf::Keyboard::isKeyPressed(sf::Keyboard::Key::LControl)) {
+    if (input.isDown(InputButton::Attack)) {
         if (!m_isAttacking) {
             m_isAttacking = true;
             m_attackTimer = sf::Time::Zero;
@@ -151,24 +162,25 @@ void Player::handleInput()
         }
     }
     
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::H)) {
-        static sf::Clock healClock;
-        if (healClock.getElapsedTime().asSeconds() > 0.5f) {
-            heal(0.5f);
-            healClock.restart();
-        }
+    // Debug keys repeat every m_debugKeyDelay while held; counted in simulation time so replays match
+    if (input.isDown(InputButton::Heal) && m_healCooldown <= sf::Time::Zero) {
+        heal(0.5f);
+        m_healCooldown = m_debugKeyDelay;
     }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::J)) {
-        static sf::Clock damageClock;
-        if (damageClock.getElapsedTime().asSeconds() > 0.5f) {
-            takeDamage(0.5f);
-            damageClock.restart();
-        }
+    if (input.isDown(InputButton::Damage) && m_damageCooldown <= sf::Time::Zero) {
+        takeDamage(0.5f);
+        m_damageCooldown = m_debugKeyDelay;
     }
 }
 
 void Player::update(const sf::Time& dt)
 {
+    GAME_PROFILE_ZONE("Player::update");
+    
+    m_previousPosition = m_position;
+    m_healCooldown = std::max(sf::Time::Zero, m_healCooldown - dt);
+    m_damageCooldown = std::max(sf::Time::Zero, m_damageCooldown - dt);
+    
     // Handle invincibility timer
     if (m_isInvincible) {
         m_invincibilityTimer += dt;
@@ -178,11 +190,12 @@ void Player::update(const sf::Time& dt)
         }
     }
     
+    using game::input::InputButton;
     sf::Vector2f move{0.f, 0.f};
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A)    || sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Left))  move.x -= 1.f;
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D)    || sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Right)) move.x += 1.f;
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::W)    || sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Up))    move.y -= 1.f;
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::S)    || sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Down))  move.y += 1.f;
+    if (m_input.isDown(InputButton::MoveLeft))  move.x -= 1.f;
+    if (m_input.isDown(InputButton::MoveRight)) move.x += 1.f;
+    if (m_input.isDown(InputButton::MoveUp))    move.y -= 1.f;
+    if (m_input.isDown(InputButton::MoveDown))  move.y += 1.f;
 
     bool wasMoving = m_isMoving;
 
@@ -244,15 +257,14 @@ void Player::update(const sf::Time& dt)
     int left = m_currentFrame * m_frameSize.x;
     int top  = m_directionCell.x * m_frameSize.y;
     
-    m_sprite.setTextureRect(sf::IntRect({left, top}, {m_frameSize.x, m_frameSize.y}));
-    m_sprite.setPosition(m_position);
-
-    static sf::Clock debugClock;
-    if (debugClock.getElapsedTime().asSeconds() > 1.f) {
-        std::cout << "Frame: " << m_currentFrame << " Dir: " << m_directionCell.x 
-                  << " Left: " << left << " Top: " << top 
-                  << " FrameSize: " << m_frameSize.x << "x" << m_frameSize.y << "\n";
-        debugClock.restart();
+    m_frameRect = sf::IntRect({left, top}, {m_frameSize.x, m_frameSize.y});
+
+    m_debugLogTimer += dt;
+    if (m_debugLogTimer >= sf::seconds(1.f)) {
+        GAME_LOG_TRACE("Frame: " << m_currentFrame << " Dir: " << m_directionCell.x 
+                       << " Left: " << left << " Top: " << top 
+                       << " FrameSize: " << m_frameSize.x << "x" << m_frameSize.y);
+        m_debugLogTimer = sf::Time::Zero;
     }
 
     sf::Vector2f swordDir = m_lastDirection;
@@ -261,80 +273,42 @@ void Player::update(const sf::Time& dt)
         swordDir /= len;
     }
 
-    float angle = std::atan2(swordDir.y, swordDir.x) * 180.f / 3.14159f;
-
-    m_sword.setPointCount(3);
-    m_sword.setPoint(0, sf::Vector2f(m_swordDistance, 0.f));
-    m_sword.setPoint(1, sf::Vector2f(0.f, -8.f));
-    m_sword.setPoint(2, sf::Vector2f(0.f,  8.f));
-    m_sword.setFillColor(sf::Color(200, 200, 200, m_isAttacking ? 255 : 0));
-    m_sword.setPosition(m_position);
-    m_sword.setRotation(sf::degrees(angle));
-}
-
-sf::ConvexShape Player::createHeart(const sf::Vector2f& position, float size) const
-{
-    sf::ConvexShape heart;
-    heart.setPointCount(12);
-    
-    float s = size;
-    heart.setPoint(0,  sf::Vector2f(0.f,       s * 0.3f));
-    heart.setPoint(1,  sf::Vector2f(-s * 0.25f, s * 0.1f));
-    heart.setPoint(2,  sf::Vector2f(-s * 0.4f, -s * 0.1f));
-    heart.setPoint(3,  sf::Vector2f(-s * 0.45f,-s * 0.3f));
-    heart.setPoint(4,  sf::Vector2f(-s * 0.4f, -s * 0.45f));
-    heart.setPoint(5,  sf::Vector2f(-s * 0.2f, -s * 0.5f));
-    heart.setPoint(6,  sf::Vector2f(0.f,       -s * 0.4f));
-    heart.setPoint(7,  sf::Vector2f(s * 0.2f,  -s * 0.5f));
-    heart.setPoint(8,  sf::Vector2f(s * 0.4f,  -s * 0.45f));
-    heart.setPoint(9,  sf::Vector2f(s * 0.45f, -s * 0.3f));
-    heart.setPoint(10, sf::Vector2f(s * 0.4f,  -s * 0.1f));
-    heart.setPoint(11, sf::Vector2f(s * 0.25f,  s * 0.1f));
-    
-    heart.setPosition(position);
-    return heart;
+    m_swordRotation = sf::radians(std::atan2(swordDir.y, swordDir.x));
 }
 
-void Player::drawHearts(sf::RenderTarget& target) const
+void Player::addArt(game::graphics::TextureAtlas& atlas) const
 {
-    const float heartSize    = 16.f;
-    const float heartSpacing = 20.f;
-    const sf::Vector2f startPos(20.f, 20.f);
-    
-    int totalHearts = static_cast<int>(std::ceil(m_maxHealth / 2.f));
-    
-    for (int i = 0; i < totalHearts; ++i) {
-        float heartValue = m_health - (i * 2.f);
-        sf::ConvexShape heart = createHeart(
-            sf::Vector2f(startPos.x + i * heartSpacing, startPos.y),
-            heartSize
-        );
-        
-        if (heartValue >= 2.f) {
-            heart.setFillColor(sf::Color::Red);
-            heart.setOutlineColor(sf::Color(139, 0, 0));
-            heart.setOutlineThickness(1.f);
-        } else if (heartValue >= 1.f) {
-            heart.setFillColor(sf::Color(255, 100, 100));
-            heart.setOutlineColor(sf::Color(139, 0, 0));
-            heart.setOutlineThickness(1.f);
-        } else {
-            heart.setFillColor(sf::Color(50, 50, 50));
-            heart.setOutlineColor(sf::Color(100, 100, 100));
-            heart.setOutlineThickness(1.f);
+    atlas.add("player", m_sheet);
+
+    // Blade pointing along +x: a triangle from the hilt edge to the tip
+    const unsigned int length = static_cast<unsigned int>(m_swordDistance);
+    const unsigned int width = 16;
+    sf::Image sword({length, width}, sf::Color::Transparent);
+    for (unsigned int y = 0; y < width; ++y) {
+        float halfWidth = std::abs(y + 0.5f - width / 2.f);
+        for (unsigned int x = 0; x < length; ++x) {
+            if (halfWidth <= (width / 2.f) * (1.f - (x + 0.5f) / length)) {
+                sword.setPixel({x, y}, sf::Color::White);
+            }
         }
-        
-        target.draw(heart);
     }
+    atlas.add("sword", sword);
 }
 
-void Player::draw(sf::RenderTarget& target) const
+void Player::draw(game::graphics::SpriteBatch& batch, const game::graphics::TextureAtlas& atlas, float alpha) const
 {
-    target.draw(m_sprite);
+    // Sprite and sword sit between the previous and the simulated position
+    sf::Vector2f renderPosition = m_previousPosition + (m_position - m_previousPosition) * alpha;
+
+    game::graphics::AtlasRegion sheet = atlas.getRegion("player");
+    game::graphics::AtlasRegion frame{sheet.texture, sf::IntRect(sheet.rect.position + m_frameRect.position, m_frameRect.size)};
+    batch.draw(game::graphics::Layer::Player, frame, sf::FloatRect(renderPosition, sf::Vector2f(m_frameSize)));
+
     if (m_isAttacking) {
-        target.draw(m_sword);
+        sf::Vector2f swordSize(m_swordDistance, 16.f);
+        batch.draw(game::graphics::Layer::Weapons, atlas.getRegion("sword"), renderPosition, swordSize,
+                   {0.f, swordSize.y / 2.f}, m_swordRotation, sf::Color(200, 200, 200));
     }
-    drawHearts(target);
 }
 
 sf::FloatRect Player::getBounds() const
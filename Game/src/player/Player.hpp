@@ -3,16 +3,25 @@
 #include <string>
 #include <vector>
 #include <functional>
+#include "../input/InputFrame.hpp"
+namespace game::assets { class AssetManager; }
+namespace game::graphics { class SpriteBatch; class TextureAtlas; }
 namespace game::player {
 class Player {
 public:
     enum class State { Idle, Walk, Attack, Dash };
     Player();
-    bool load(const std::string& texturePath, const sf::Vector2i& frameSize = {32,32}, unsigned int framesPerRow = 3);
+    // The spritesheet comes from the asset cache, so loading it again (e.g. on restart) doesn't touch the disk
+    bool load(game::assets::AssetManager& assets, const std::string& texturePath,
+              const sf::Vector2i& frameSize = {32,32}, unsigned int framesPerRow = 3);
     void update(const sf::Time& dt);
-    void handleInput();
-    void draw(sf::RenderTarget& target) const;
+    void handleInput(const game::input::InputFrame& input);
+    // Add the spritesheet and sword art; call before the atlas is built
+    void addArt(game::graphics::TextureAtlas& atlas) const;
+    // alpha places the sprite between the previous and the current step
+    void draw(game::graphics::SpriteBatch& batch, const game::graphics::TextureAtlas& atlas, float alpha = 1.f) const;
     void setPosition(const sf::Vector2f& pos);
+    void teleport(const sf::Vector2f& pos);   // Move without interpolating from the old position
     sf::Vector2f getPosition() const;
     
     // Health management
@@ -25,14 +34,12 @@ public:
     // Collision detection
     sf::FloatRect getBounds() const;
     bool checkCollision(const sf::CircleShape& circle) const;
+    bool checkCollision(const sf::Vector2f& circleCenter, float radius) const;
     sf::FloatRect getSwordBounds() const;
     
     bool isAttacking() const { return m_isAttacking; }
     sf::Vector2f getPendingPosition() const { return m_pendingPosition; }
-    void commitPosition() { 
-        m_position = m_pendingPosition; 
-        m_sprite.setPosition(m_position); 
-    }
+    void commitPosition() { m_position = m_pendingPosition; }
 
     // Sound callbacks
     void setOnWalkStartCallback(std::function<void()> callback) { m_onWalkStartCallback = callback; }
@@ -42,11 +49,13 @@ public:
     void setOnDeathCallback(std::function<void()> callback)     { m_onDeathCallback     = callback; }
     
 private:
-    sf::Texture m_texture;
-    sf::Sprite m_sprite;
+    sf::Image m_sheet;                 // Spritesheet, drawn from the texture atlas
+    sf::IntRect m_frameRect;           // Current frame within m_sheet
     sf::Vector2f m_position{0.f,0.f};
+    sf::Vector2f m_previousPosition{0.f, 0.f};   // Position at the start of the last update()
     sf::Vector2f m_pendingPosition{0.f, 0.f};
     float m_speed = 140.f;
+    game::input::InputFrame m_input;   // Latest frame from handleInput()
     
     // Animation
     sf::Vector2i m_frameSize{16,16};
@@ -58,7 +67,7 @@ private:
     sf::Vector2i m_directionCell{0,0};
     
     // Sword attack
-    sf::ConvexShape m_sword;
+    sf::Angle m_swordRotation;
     bool m_isAttacking = false;
     sf::Time m_attackDuration = sf::seconds(0.3f);
     sf::Time m_attackTimer = sf::Time::Zero;
@@ -74,9 +83,11 @@ private:
     sf::Time m_invincibilityDuration = sf::seconds(1.5f);
     sf::Time m_invincibilityTimer = sf::Time::Zero;
     
-    // Heart rendering
-    void drawHearts(sf::RenderTarget& target) const;
-    sf::ConvexShape createHeart(const sf::Vector2f& position, float size) const;
+    // Debug heal/damage key repeat
+    sf::Time m_debugKeyDelay = sf::seconds(0.5f);
+    sf::Time m_healCooldown = sf::Time::Zero;
+    sf::Time m_damageCooldown = sf::Time::Zero;
+    sf::Time m_debugLogTimer = sf::Time::Zero;   // Throttles the animation trace log
 
     // Sound callbacks
     std::function<void()> m_onWalkStartCallback;
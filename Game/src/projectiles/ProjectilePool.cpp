@@ -0,0 +1,181 @@
+#include "ProjectilePool.hpp"
+#include "../graphics/SpriteBatch.hpp"
+#include <algorithm>
+
+namespace game::projectiles {
+
+ProjectilePool::ProjectilePool(std::size_t capacity)
+{
+    m_posX.reserve(capacity);
+    m_posY.reserve(capacity);
+    m_prevX.reserve(capacity);
+    m_prevY.reserve(capacity);
+    m_velX.reserve(capacity);
+    m_velY.reserve(capacity);
+    m_radius.reserve(capacity);
+    m_owner.reserve(capacity);
+    m_alive.reserve(capacity);
+    m_slotOf.reserve(capacity);
+}
+
+ProjectileHandle ProjectilePool::spawn(const sf::Vector2f& position, const sf::Vector2f& velocity,
+                                       float radius, std::uint32_t owner)
+{
+    std::uint32_t slot;
+    if (!m_freeSlots.empty()) {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    } else {
+        slot = static_cast<std::uint32_t>(m_indexOf.size());
+        m_indexOf.push_back(0);
+        m_generation.push_back(0);
+    }
+
+    m_indexOf[slot] = static_cast<std::uint32_t>(m_posX.size());
+
+    m_posX.push_back(position.x);
+    m_posY.push_back(position.y);
+    m_prevX.push_back(position.x);
+    m_prevY.push_back(position.y);
+    m_velX.push_back(velocity.x);
+    m_velY.push_back(velocity.y);
+    m_radius.push_back(radius);
+    m_owner.push_back(owner);
+    m_alive.push_back(1);
+    m_slotOf.push_back(slot);
+
+    return {slot, m_generation[slot]};
+}
+
+bool ProjectilePool::isValid(const ProjectileHandle& handle) const
+{
+    return handle.slot < m_generation.size() && m_generation[handle.slot] == handle.generation;
+}
+
+void ProjectilePool::kill(const ProjectileHandle& handle)
+{
+    if (isValid(handle)) {
+        kill(m_indexOf[handle.slot]);
+    }
+}
+
+sf::FloatRect ProjectilePool::getBounds(std::size_t index) const
+{
+    float radius = m_radius[index];
+    return sf::FloatRect(
+        sf::Vector2f(m_posX[index] - radius, m_posY[index] - radius),
+        sf::Vector2f(radius * 2.f, radius * 2.f)
+    );
+}
+
+void ProjectilePool::update(const sf::Time& dt, const sf::FloatRect& bounds)
+{
+    const std::size_t count = m_posX.size();
+    const float seconds = dt.asSeconds();
+
+    std::copy(m_posX.begin(), m_posX.end(), m_prevX.begin());
+    std::copy(m_posY.begin(), m_posY.end(), m_prevY.begin());
+
+    // Straight loops over contiguous floats with no branches, so the compiler can vectorise them
+    float* posX = m_posX.data();
+    float* posY = m_posY.data();
+    const float* velX = m_velX.data();
+    const float* velY = m_velY.data();
+    for (std::size_t i = 0; i < count; ++i) {
+        posX[i] += velX[i] * seconds;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        posY[i] += velY[i] * seconds;
+    }
+
+    const float minX = bounds.position.x;
+    const float minY = bounds.position.y;
+    const float maxX = bounds.position.x + bounds.size.x;
+    const float maxY = bounds.position.y + bounds.size.y;
+    std::uint8_t* alive = m_alive.data();
+    for (std::size_t i = 0; i < count; ++i) {
+        alive[i] &= static_cast<std::uint8_t>((posX[i] >= minX) & (posX[i] <= maxX) &
+                                              (posY[i] >= minY) & (posY[i] <= maxY));
+    }
+
+    // Swap-remove from the back so every element is visited once
+    for (std::size_t i = count; i-- > 0; ) {
+        if (!m_alive[i]) {
+            removeAt(i);
+        }
+    }
+}
+
+void ProjectilePool::removeAt(std::size_t index)
+{
+    std::size_t last = m_posX.size() - 1;
+    std::uint32_t slot = m_slotOf[index];
+
+    if (index != last) {
+        m_posX[index] = m_posX[last];
+        m_posY[index] = m_posY[last];
+        m_prevX[index] = m_prevX[last];
+        m_prevY[index] = m_prevY[last];
+        m_velX[index] = m_velX[last];
+        m_velY[index] = m_velY[last];
+        m_radius[index] = m_radius[last];
+        m_owner[index] = m_owner[last];
+        m_alive[index] = m_alive[last];
+        m_slotOf[index] = m_slotOf[last];
+        m_indexOf[m_slotOf[index]] = static_cast<std::uint32_t>(index);
+    }
+
+    m_posX.pop_back();
+    m_posY.pop_back();
+    m_prevX.pop_back();
+    m_prevY.pop_back();
+    m_velX.pop_back();
+    m_velY.pop_back();
+    m_radius.pop_back();
+    m_owner.pop_back();
+    m_alive.pop_back();
+    m_slotOf.pop_back();
+
+    ++m_generation[slot];
+    m_freeSlots.push_back(slot);
+}
+
+void ProjectilePool::clear()
+{
+    for (std::uint32_t slot : m_slotOf) {
+        ++m_generation[slot];
+        m_freeSlots.push_back(slot);
+    }
+
+    m_posX.clear();
+    m_posY.clear();
+    m_prevX.clear();
+    m_prevY.clear();
+    m_velX.clear();
+    m_velY.clear();
+    m_radius.clear();
+    m_owner.clear();
+    m_alive.clear();
+    m_slotOf.clear();
+}
+
+void ProjectilePool::draw(game::graphics::SpriteBatch& batch, const game::graphics::AtlasRegion& circle,
+                          const sf::FloatRect& viewBounds, float alpha) const
+{
+    const float minX = viewBounds.position.x;
+    const float minY = viewBounds.position.y;
+    const float maxX = viewBounds.position.x + viewBounds.size.x;
+    const float maxY = viewBounds.position.y + viewBounds.size.y;
+
+    for (std::size_t i = 0; i < m_posX.size(); ++i) {
+        float x = m_prevX[i] + (m_posX[i] - m_prevX[i]) * alpha;
+        float y = m_prevY[i] + (m_posY[i] - m_prevY[i]) * alpha;
+        float r = m_radius[i];
+        if (!m_alive[i] || x + r < minX || x - r > maxX || y + r < minY || y - r > maxY) continue;
+
+        batch.draw(game::graphics::Layer::Projectiles, circle,
+                   sf::FloatRect({x - r, y - r}, {r * 2.f, r * 2.f}), sf::Color::Yellow);
+    }
+}
+
+} // namespace game::projectiles
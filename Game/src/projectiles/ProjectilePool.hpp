@@ -0,0 +1,73 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace game::graphics { class SpriteBatch; struct AtlasRegion; }
+
+namespace game::projectiles {
+
+// Stable reference to a projectile; goes stale once the projectile is removed
+struct ProjectileHandle {
+    std::uint32_t slot = 0;
+    std::uint32_t generation = 0;
+};
+
+// Every live projectile in the game, stored as parallel arrays (structure of arrays).
+// Live projectiles are packed at [0, size()), so update() is a few straight loops over
+// floats and dead ones are swap-removed. Handles go through a slot table whose freed
+// slots are reused, so they stay valid while the packed index moves around.
+class ProjectilePool {
+public:
+    explicit ProjectilePool(std::size_t capacity = 1024);
+
+    ProjectileHandle spawn(const sf::Vector2f& position, const sf::Vector2f& velocity,
+                           float radius = 4.f, std::uint32_t owner = 0);
+
+    // Flag for removal; the slot is reclaimed in the next update()
+    void kill(std::size_t index) { m_alive[index] = 0; }
+    void kill(const ProjectileHandle& handle);
+
+    // Move everything, flag projectiles that left `bounds`, then compact
+    void update(const sf::Time& dt, const sf::FloatRect& bounds);
+
+    // Queue a tinted `circle` quad for every projectile inside the view, placed `alpha`
+    // of the way from the previous to the current update()
+    void draw(game::graphics::SpriteBatch& batch, const game::graphics::AtlasRegion& circle,
+              const sf::FloatRect& viewBounds, float alpha = 1.f) const;
+
+    void clear();
+
+    // Packed access, valid until the next update()
+    std::size_t size() const { return m_posX.size(); }
+    bool isAlive(std::size_t index) const { return m_alive[index] != 0; }
+    sf::Vector2f getPosition(std::size_t index) const { return {m_posX[index], m_posY[index]}; }
+    float getRadius(std::size_t index) const { return m_radius[index]; }
+    std::uint32_t getOwner(std::size_t index) const { return m_owner[index]; }
+    sf::FloatRect getBounds(std::size_t index) const;
+
+    bool isValid(const ProjectileHandle& handle) const;
+
+private:
+    void removeAt(std::size_t index);
+
+    // Packed projectile data
+    std::vector<float> m_posX;
+    std::vector<float> m_posY;
+    std::vector<float> m_prevX;                 // Position before the last update()
+    std::vector<float> m_prevY;
+    std::vector<float> m_velX;
+    std::vector<float> m_velY;
+    std::vector<float> m_radius;
+    std::vector<std::uint32_t> m_owner;
+    std::vector<std::uint8_t> m_alive;
+    std::vector<std::uint32_t> m_slotOf;        // Packed index -> slot
+
+    // Slot table for handles
+    std::vector<std::uint32_t> m_indexOf;       // Slot -> packed index
+    std::vector<std::uint32_t> m_generation;    // Bumped whenever a slot is freed
+    std::vector<std::uint32_t> m_freeSlots;
+
+};
+
+} // namespace game::projectiles
@@ -0,0 +1,256 @@
+#include "Headless.hpp"
+#include "Simulation.hpp"
+#include "../core/Log.hpp"
+#include "../core/Profiler.hpp"
+#include "../ecs/Systems.hpp"
+#include "../entities/enemies/Octorok.hpp"
+#include "../input/InputRecording.hpp"
+#include "../input/ScriptedInput.hpp"
+#include "../player/Player.hpp"
+#include "../projectiles/ProjectilePool.hpp"
+#include "../world/World.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace game::sim {
+
+namespace {
+
+constexpr float TileSize = 32.f;
+const sf::Time Step = sf::seconds(1.f / 120.f);
+
+std::size_t getPeakRssBytes()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+    return static_cast<std::size_t>(usage.ru_maxrss);           // Bytes
+#else
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024;    // Kilobytes
+#endif
+#endif
+}
+
+// Random walkable spot away from the player's spawn
+sf::Vector2f findSpawnPoint(const game::world::World& world, const sf::Vector2f& avoid, std::mt19937_64& rng)
+{
+    sf::FloatRect bounds = world.getWorldBounds();
+    std::uniform_real_distribution<float> xDist(bounds.position.x + TileSize, bounds.position.x + bounds.size.x - TileSize);
+    std::uniform_real_distribution<float> yDist(bounds.position.y + TileSize, bounds.position.y + bounds.size.y - TileSize);
+
+    sf::Vector2f position;
+    for (int attempt = 0; attempt < 64; ++attempt) {
+        position = {xDist(rng), yDist(rng)};
+        sf::Vector2f offset = position - avoid;
+        if (world.isWalkable(position) && offset.x * offset.x + offset.y * offset.y > 300.f * 300.f) break;
+    }
+    return position;
+}
+
+double percentile(std::vector<double>& values, double fraction)
+{
+    if (values.empty()) return 0.0;
+    std::size_t index = std::min(values.size() - 1, static_cast<std::size_t>(fraction * values.size()));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+bool parseNumber(const char* text, std::uint64_t& value)
+{
+    char* end = nullptr;
+    unsigned long long parsed = std::strtoull(text, &end, 10);
+    if (end == text || *end != '\0') return false;
+    value = parsed;
+    return true;
+}
+
+} // namespace
+
+bool parseHeadlessOptions(int argc, char* argv[], HeadlessOptions& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--headless") continue;
+
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return false;
+        }
+        const char* value = argv[++i];
+
+        std::uint64_t number = 0;
+        if (arg == "--world") {
+            unsigned int width = 0;
+            unsigned int height = 0;
+            if (std::sscanf(value, "%ux%u", &width, &height) != 2 || width == 0 || height == 0) {
+                std::cerr << "Expected --world WIDTHxHEIGHT, got " << value << "\n";
+                return false;
+            }
+            options.worldWidth = width;
+            options.worldHeight = height;
+        } else if (arg == "--enemies" && parseNumber(value, number)) {
+            options.enemyCount = static_cast<std::size_t>(number);
+        } else if (arg == "--ticks" && parseNumber(value, number)) {
+            options.ticks = number;
+        } else if (arg == "--seed" && parseNumber(value, number)) {
+            options.seed = number;
+        } else if (arg == "--record") {
+            options.recordPath = value;
+        } else if (arg == "--replay") {
+            options.replayPath = value;
+        } else {
+            std::cerr << "Unknown or invalid argument: " << arg << " " << value << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+int runHeadless(const HeadlessOptions& requested)
+{
+    using Clock = std::chrono::steady_clock;
+
+    // A replay brings its own setup, otherwise the run would not match the recording
+    HeadlessOptions options = requested;
+    game::input::InputReplay replay;
+    if (!options.replayPath.empty()) {
+        if (!replay.load(options.replayPath)) return 1;
+
+        const game::input::RecordingInfo& info = replay.getInfo();
+        options.worldWidth = info.worldWidth;
+        options.worldHeight = info.worldHeight;
+        options.seed = info.seed;
+        options.enemyCount = info.enemyCount;
+        options.ticks = replay.getFrameCount();
+    }
+
+    std::cout << "Headless run: " << options.worldWidth << "x" << options.worldHeight << " tiles, "
+              << options.enemyCount << " enemies, " << options.ticks << " ticks, seed " << options.seed << "\n";
+
+    Clock::time_point setupStart = Clock::now();
+
+    game::world::World world(options.worldWidth, options.worldHeight, TileSize);
+    world.setSeed(options.seed);
+    world.generate();
+
+    // No textures are loaded: there is no GL context, and the simulation only needs bounds
+    game::player::Player player;
+    sf::Vector2f spawn(world.getWorldBounds().size.x / 2.f, world.getWorldBounds().size.y / 2.f);
+    player.teleport(spawn);
+
+    game::ecs::Registry registry;
+    game::projectiles::ProjectilePool projectiles;
+    std::mt19937_64 rng(options.seed);
+    auto topUpEnemies = [&]() {
+        while (registry.storage<game::ecs::Health>().size() < options.enemyCount) {
+            game::enemies::spawnOctorok(registry, findSpawnPoint(world, player.getPosition(), rng));
+        }
+    };
+    if (options.enemyCount == 0) {
+        spawnStartingEnemies(registry);
+    }
+    topUpEnemies();
+
+    Simulation simulation(world, player, registry, projectiles, options.seed);
+    game::input::ScriptedInput script(options.seed);
+
+    game::input::InputRecorder recorder;
+    if (!options.recordPath.empty()) {
+        game::input::RecordingInfo info;
+        info.worldWidth = options.worldWidth;
+        info.worldHeight = options.worldHeight;
+        info.seed = options.seed;
+        info.tickRate = static_cast<std::uint32_t>(1.f / Step.asSeconds() + 0.5f);
+        info.enemyCount = static_cast<std::uint32_t>(options.enemyCount);
+        if (!recorder.open(options.recordPath, info)) return 1;
+    }
+
+    double setupMs = std::chrono::duration<double, std::milli>(Clock::now() - setupStart).count();
+    // The report goes straight to stdout; let setup messages land first
+    game::core::Logger::instance().flush();
+    std::cout << "Setup: " << setupMs << " ms\n";
+
+    std::vector<double> tickMicros;
+    tickMicros.reserve(static_cast<std::size_t>(options.ticks));
+    std::size_t playerDeaths = 0;
+    std::size_t peakProjectiles = 0;
+
+    game::core::Profiler& profiler = game::core::Profiler::instance();
+    Clock::time_point runStart = Clock::now();
+    for (std::uint64_t tick = 0; tick < options.ticks; ++tick) {
+        Clock::time_point tickStart = Clock::now();
+
+        game::input::InputFrame input;
+        if (options.replayPath.empty()) {
+            input = script.next();
+        } else if (!replay.next(input)) {
+            break;
+        }
+        recorder.record(input);
+
+        simulation.step(input, Step);
+
+        // Keep the load steady: the player comes back and so do the enemies they killed
+        if (!player.isAlive()) {
+            ++playerDeaths;
+            player = game::player::Player();
+            player.teleport(spawn);
+        }
+        topUpEnemies();
+
+        tickMicros.push_back(std::chrono::duration<double, std::micro>(Clock::now() - tickStart).count());
+        peakProjectiles = std::max(peakProjectiles, projectiles.size());
+        profiler.endFrame();
+    }
+    double runSeconds = std::chrono::duration<double>(Clock::now() - runStart).count();
+    std::uint64_t ticksRun = tickMicros.size();
+
+    if (!recorder.close()) return 1;
+
+    double p50 = percentile(tickMicros, 0.50);
+    double p99 = percentile(tickMicros, 0.99);
+    double worst = tickMicros.empty() ? 0.0 : *std::max_element(tickMicros.begin(), tickMicros.end());
+
+    std::cout << "Ticks/sec: " << (runSeconds > 0.0 ? ticksRun / runSeconds : 0.0)
+              << " (" << runSeconds << " s wall for " << ticksRun * Step.asSeconds() << " s simulated)\n";
+    std::cout << "Tick time: p50 " << p50 << " us, p99 " << p99 << " us, max " << worst << " us\n";
+    std::cout << "Peak RSS: " << getPeakRssBytes() / (1024.0 * 1024.0) << " MB\n";
+    std::cout << "Peak projectiles: " << peakProjectiles << ", player deaths: " << playerDeaths << "\n";
+
+    // Per-zone cost over the last Profiler::HistoryFrames ticks
+    for (const auto& zone : profiler.getStats()) {
+        char line[128];
+        std::snprintf(line, sizeof(line), "  %-28s avg %8.3f ms  worst %8.3f ms\n",
+                      zone.name.c_str(), zone.averageMs, zone.worstMs);
+        std::cout << line;
+    }
+
+    char hash[17];
+    std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(simulation.getStateHash()));
+    std::cout << "State hash: " << hash << "\n";
+    return 0;
+}
+
+} // namespace game::sim
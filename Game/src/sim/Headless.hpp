@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace game::sim {
+
+struct HeadlessOptions {
+    unsigned int worldWidth = 256;     // Tiles
+    unsigned int worldHeight = 256;
+    std::size_t enemyCount = 1000;     // Kept constant: killed enemies respawn elsewhere. 0 = the game's starting enemies
+    std::uint64_t ticks = 120 * 60;    // One simulated minute at 120 Hz
+    std::uint64_t seed = 1;            // World, enemy placement and scripted input
+    std::string recordPath;            // Save the input frames that were played
+    std::string replayPath;            // Play a recording instead of scripted input (sets world, seed, enemies and ticks)
+};
+
+// Reads --world WxH, --enemies N, --ticks N, --seed N, --record FILE and --replay FILE;
+// unknown arguments are an error
+bool parseHeadlessOptions(int argc, char* argv[], HeadlessOptions& options);
+
+// Run the simulation without a window on scripted input and print throughput,
+// tick time percentiles and peak memory. Returns the process exit code.
+int runHeadless(const HeadlessOptions& options);
+
+} // namespace game::sim
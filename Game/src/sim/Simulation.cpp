@@ -0,0 +1,129 @@
+#include "Simulation.hpp"
+#include "../core/Profiler.hpp"
+#include "../ecs/Systems.hpp"
+#include "../entities/enemies/Octorok.hpp"
+#include "../player/Player.hpp"
+#include "../projectiles/ProjectilePool.hpp"
+#include "../world/World.hpp"
+#include <cstring>
+
+namespace game::sim {
+
+Simulation::Simulation(game::world::World& world, game::player::Player& player,
+                       game::ecs::Registry& registry, game::projectiles::ProjectilePool& projectiles,
+                       std::uint64_t seed)
+    : m_world(world)
+    , m_player(player)
+    , m_registry(registry)
+    , m_projectiles(projectiles)
+    , m_spatialHash(world.getTileSize())
+    , m_rng(static_cast<std::mt19937::result_type>(seed ^ (seed >> 32)))
+{
+}
+
+void Simulation::step(const game::input::InputFrame& input, const sf::Time& dt)
+{
+    using game::world::SpatialCategory;
+    GAME_PROFILE_ZONE("Simulation::step");
+
+    m_player.handleInput(input);
+    m_player.update(dt);
+
+    // Sweep the player's box along its move and slide along any wall it hits
+    sf::Vector2f playerMove = m_player.getPendingPosition() - m_player.getPosition();
+    m_player.setPosition(m_player.getPosition() + m_world.moveAndSlide(m_player.getBounds(), playerMove));
+
+    {
+        GAME_PROFILE_ZONE("Simulation::enemies");
+        // Enemy systems run over packed component arrays
+        game::ecs::updateAI(m_registry, m_player.getPosition(), dt, m_rng);
+        game::ecs::updateMovement(m_registry, m_world, dt);
+        game::ecs::updateFlash(m_registry, dt);
+        game::ecs::updateShooters(m_registry, m_projectiles, dt);
+    }
+
+    {
+        GAME_PROFILE_ZONE("Simulation::projectiles");
+        // One pass over every projectile; anything that leaves the map is dropped
+        m_projectiles.update(dt, m_world.getWorldBounds());
+    }
+
+    {
+        GAME_PROFILE_ZONE("Simulation::hitTests");
+        // Register everything that moved so hit tests only look at nearby entries
+        m_spatialHash.clear();
+        m_spatialHash.insert(0, SpatialCategory::Player, m_player.getBounds());
+        const auto& enemyTransforms = m_registry.storage<game::ecs::Transform>();
+        for (std::size_t i = 0; i < enemyTransforms.size(); ++i) {
+            m_spatialHash.insert(enemyTransforms.entities()[i], SpatialCategory::Enemy,
+                                 game::ecs::getBounds(enemyTransforms.components()[i]));
+        }
+        for (std::size_t i = 0; i < m_projectiles.size(); ++i) {
+            m_spatialHash.insert(static_cast<std::uint32_t>(i), SpatialCategory::Projectile, m_projectiles.getBounds(i));
+        }
+
+        if (m_player.isAttacking()) {
+            m_spatialHash.query(m_player.getSwordBounds(), SpatialCategory::Enemy, [&](std::uint32_t id) {
+                bool killed = game::ecs::applyDamage(m_registry, id, 1.f);
+                if (m_onEnemyHitCallback) {
+                    const game::ecs::Transform* transform = m_registry.find<game::ecs::Transform>(id);
+                    m_onEnemyHitCallback(transform ? transform->position : m_player.getPosition(), killed);
+                }
+            });
+        }
+
+        m_spatialHash.query(m_player.getBounds(), SpatialCategory::Projectile, [&](std::uint32_t id) {
+            if (m_projectiles.isAlive(id) && m_projectiles.getOwner(id) != SpatialCategory::Player &&
+                m_player.checkCollision(m_projectiles.getPosition(id), m_projectiles.getRadius(id))) {
+                m_projectiles.kill(id);
+                m_player.takeDamage(0.5f);
+            }
+        });
+
+        // Remove dead enemies
+        game::ecs::destroyDead(m_registry);
+    }
+}
+
+std::uint64_t Simulation::getStateHash() const
+{
+    // FNV-1a over the raw bits, so any drift at all changes the hash
+    std::uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](float value) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        for (int i = 0; i < 4; ++i) {
+            hash = (hash ^ ((bits >> (i * 8)) & 0xFF)) * 1099511628211ull;
+        }
+    };
+
+    mix(m_player.getPosition().x);
+    mix(m_player.getPosition().y);
+    mix(m_player.getHealth());
+
+    const auto& transforms = m_registry.storage<game::ecs::Transform>().components();
+    for (const auto& transform : transforms) {
+        mix(transform.position.x);
+        mix(transform.position.y);
+    }
+    for (const auto& health : m_registry.storage<game::ecs::Health>().components()) {
+        mix(health.current);
+    }
+
+    for (std::size_t i = 0; i < m_projectiles.size(); ++i) {
+        mix(m_projectiles.getPosition(i).x);
+        mix(m_projectiles.getPosition(i).y);
+    }
+    return hash;
+}
+
+void spawnStartingEnemies(game::ecs::Registry& registry)
+{
+    game::enemies::spawnOctorok(registry, { 400.f, 300.f});
+    game::enemies::spawnOctorok(registry, { 600.f, 400.f});
+    game::enemies::spawnOctorok(registry, { 800.f, 500.f});
+    game::enemies::spawnOctorok(registry, { 300.f, 600.f});
+    game::enemies::spawnOctorok(registry, {1000.f, 400.f});
+}
+
+} // namespace game::sim
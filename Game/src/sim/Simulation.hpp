@@ -0,0 +1,47 @@
+#pragma once
+#include "../ecs/Registry.hpp"
+#include "../input/InputFrame.hpp"
+#include "../world/SpatialHash.hpp"
+#include <SFML/System.hpp>
+#include <cstdint>
+#include <functional>
+#include <random>
+
+namespace game::world { class World; }
+namespace game::player { class Player; }
+namespace game::projectiles { class ProjectilePool; }
+
+namespace game::sim {
+
+// One gameplay step: player, enemies, projectiles and hit tests. Needs no window,
+// so the same code runs in the game loop and in headless benchmarks.
+class Simulation {
+public:
+    // Same seed, same starting state and same input frames give the same run
+    Simulation(game::world::World& world, game::player::Player& player,
+               game::ecs::Registry& registry, game::projectiles::ProjectilePool& projectiles,
+               std::uint64_t seed);
+
+    void step(const game::input::InputFrame& input, const sf::Time& dt);
+
+    // Hash of player, enemy and projectile state; equal hashes after a replay mean nothing diverged
+    std::uint64_t getStateHash() const;
+
+    // Fired for every sword hit; `killed` is true for the blow that finished the enemy
+    void setOnEnemyHitCallback(std::function<void(const sf::Vector2f& position, bool killed)> callback) { m_onEnemyHitCallback = callback; }
+
+private:
+    game::world::World& m_world;
+    game::player::Player& m_player;
+    game::ecs::Registry& m_registry;
+    game::projectiles::ProjectilePool& m_projectiles;
+
+    game::world::SpatialHash m_spatialHash;   // Broadphase for hit tests, one cell per tile
+    std::mt19937 m_rng;                       // All gameplay randomness
+    std::function<void(const sf::Vector2f&, bool)> m_onEnemyHitCallback;
+};
+
+// The enemies a new game starts with
+void spawnStartingEnemies(game::ecs::Registry& registry);
+
+} // namespace game::sim
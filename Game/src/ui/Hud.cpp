@@ -0,0 +1,159 @@
+#include "Hud.hpp"
+#include "../player/Player.hpp"
+#include <array>
+#include <cmath>
+
+namespace game::ui {
+
+namespace {
+
+constexpr float HeartSize = 16.f;
+constexpr float HeartSpacing = 20.f;
+constexpr float OutlineThickness = 1.f;
+
+// Heart outline in units of HeartSize, centred on the origin
+constexpr std::size_t HeartPointCount = 12;
+constexpr std::array<sf::Vector2f, HeartPointCount> HeartShape = {{
+    {0.f,    0.3f},
+    {-0.25f, 0.1f},
+    {-0.4f, -0.1f},
+    {-0.45f, -0.3f},
+    {-0.4f, -0.45f},
+    {-0.2f, -0.5f},
+    {0.f,   -0.4f},
+    {0.2f,  -0.5f},
+    {0.4f,  -0.45f},
+    {0.45f, -0.3f},
+    {0.4f,  -0.1f},
+    {0.25f,  0.1f},
+}};
+
+struct HeartGeometry {
+    std::array<sf::Vector2f, HeartPointCount> inner;
+    std::array<sf::Vector2f, HeartPointCount> outer;   // Inner points pushed out by the outline thickness
+    sf::Vector2f centroid;
+};
+
+sf::Vector2f normalize(const sf::Vector2f& v)
+{
+    float length = std::sqrt(v.x * v.x + v.y * v.y);
+    return length > 0.f ? v / length : v;
+}
+
+void appendTriangle(sf::VertexArray& vertices, const sf::Vector2f& a, const sf::Vector2f& b,
+                    const sf::Vector2f& c, const sf::Color& color)
+{
+    std::size_t first = vertices.getVertexCount();
+    vertices.resize(first + 3);
+    vertices[first].position = a;
+    vertices[first + 1].position = b;
+    vertices[first + 2].position = c;
+    for (std::size_t i = first; i < first + 3; ++i) {
+        vertices[i].color = color;
+    }
+}
+
+// Scaled and outlined once; every heart is a translated copy
+const HeartGeometry& getHeartGeometry()
+{
+    static const HeartGeometry geometry = [] {
+        HeartGeometry g;
+        for (std::size_t i = 0; i < HeartPointCount; ++i) {
+            g.inner[i] = HeartShape[i] * HeartSize;
+            g.centroid += g.inner[i];
+        }
+        g.centroid /= static_cast<float>(HeartPointCount);
+
+        // Mitred outline like sf::Shape, with normals flipped to point away from the centre
+        for (std::size_t i = 0; i < HeartPointCount; ++i) {
+            const sf::Vector2f& prev = g.inner[(i + HeartPointCount - 1) % HeartPointCount];
+            const sf::Vector2f& point = g.inner[i];
+            const sf::Vector2f& next = g.inner[(i + 1) % HeartPointCount];
+
+            sf::Vector2f n1 = normalize({prev.y - point.y, point.x - prev.x});
+            sf::Vector2f n2 = normalize({point.y - next.y, next.x - point.x});
+            if (n1.x * (g.centroid.x - point.x) + n1.y * (g.centroid.y - point.y) > 0.f) n1 = -n1;
+            if (n2.x * (g.centroid.x - point.x) + n2.y * (g.centroid.y - point.y) > 0.f) n2 = -n2;
+
+            float factor = 1.f + (n1.x * n2.x + n1.y * n2.y);
+            sf::Vector2f normal = factor > 1e-4f ? (n1 + n2) / factor : n1;
+            g.outer[i] = point + normal * OutlineThickness;
+        }
+        return g;
+    }();
+    return geometry;
+}
+
+} // namespace
+
+Hud::Hud()
+    : m_vertices(sf::PrimitiveType::Triangles)
+{
+}
+
+void Hud::update(const player::Player& player)
+{
+    if (player.getHealth() != m_health || player.getMaxHealth() != m_maxHealth) {
+        m_health = player.getHealth();
+        m_maxHealth = player.getMaxHealth();
+        m_dirty = true;
+    }
+
+    if (m_dirty) {
+        rebuild();
+        m_dirty = false;
+    }
+}
+
+void Hud::draw(sf::RenderTarget& target) const
+{
+    if (m_vertices.getVertexCount() > 0) {
+        target.draw(m_vertices);
+    }
+}
+
+void Hud::rebuild()
+{
+    m_vertices.clear();
+
+    // Each heart is two points of health
+    int totalHearts = static_cast<int>(std::ceil(m_maxHealth / 2.f));
+    for (int i = 0; i < totalHearts; ++i) {
+        float heartValue = m_health - (i * 2.f);
+        sf::Vector2f center(m_heartsOrigin.x + i * HeartSpacing, m_heartsOrigin.y);
+
+        if (heartValue >= 2.f) {
+            appendHeart(center, sf::Color::Red, sf::Color(139, 0, 0));
+        } else if (heartValue >= 1.f) {
+            appendHeart(center, sf::Color(255, 100, 100), sf::Color(139, 0, 0));
+        } else {
+            appendHeart(center, sf::Color(50, 50, 50), sf::Color(100, 100, 100));
+        }
+    }
+}
+
+void Hud::appendHeart(const sf::Vector2f& center, const sf::Color& fill, const sf::Color& outline)
+{
+    const HeartGeometry& g = getHeartGeometry();
+
+    // Outline first so the fill covers its inner edge
+    for (std::size_t i = 0; i < HeartPointCount; ++i) {
+        std::size_t j = (i + 1) % HeartPointCount;
+        sf::Vector2f a = center + g.inner[i];
+        sf::Vector2f b = center + g.outer[i];
+        sf::Vector2f c = center + g.inner[j];
+        sf::Vector2f d = center + g.outer[j];
+
+        appendTriangle(m_vertices, a, b, c, outline);
+        appendTriangle(m_vertices, c, b, d, outline);
+    }
+
+    // Fan around the centroid, as sf::ConvexShape triangulates
+    sf::Vector2f middle = center + g.centroid;
+    for (std::size_t i = 0; i < HeartPointCount; ++i) {
+        std::size_t j = (i + 1) % HeartPointCount;
+        appendTriangle(m_vertices, middle, center + g.inner[i], center + g.inner[j], fill);
+    }
+}
+
+} // namespace game::ui
@@ -0,0 +1,31 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+
+namespace game::player { class Player; }
+
+namespace game::ui {
+
+// Screen-space overlay for gameplay widgets (currently the player's hearts).
+// Geometry is rebuilt only when the state it shows changes and is drawn with a single call.
+class Hud {
+public:
+    Hud();
+
+    // Cheap when nothing changed; call once per frame
+    void update(const player::Player& player);
+    void draw(sf::RenderTarget& target) const;
+
+    void setHeartsOrigin(const sf::Vector2f& origin) { m_heartsOrigin = origin; m_dirty = true; }
+
+private:
+    void rebuild();
+    void appendHeart(const sf::Vector2f& center, const sf::Color& fill, const sf::Color& outline);
+
+    sf::VertexArray m_vertices;
+    sf::Vector2f m_heartsOrigin{20.f, 44.f};   // Below the FPS counter
+    float m_health = -1.f;
+    float m_maxHealth = -1.f;
+    bool m_dirty = true;
+};
+
+} // namespace game::ui
@@ -1,5 +1,6 @@
 #include "Camera.hpp"
 #include <algorithm>
+#include <cmath>
 
 namespace game::world {
 
@@ -7,17 +8,21 @@ Camera::Camera(const sf::Vector2f& viewSize, const sf::FloatRect& worldBounds)
     : m_worldBounds(worldBounds)
 {
     m_view.setSize(viewSize);
-    m_view.setCenter(sf::Vector2f(viewSize.x / 2.f, viewSize.y / 2.f));
+    m_center = sf::Vector2f(viewSize.x / 2.f, viewSize.y / 2.f);
+    m_previousCenter = m_center;
+    m_view.setCenter(m_center);
 }
 
-void Camera::update(const sf::Vector2f& targetPosition)
+void Camera::update(const sf::Vector2f& targetPosition, const sf::Time& dt)
 {
     // Smooth camera follow
-    sf::Vector2f currentCenter = m_view.getCenter();
+    m_previousCenter = m_center;
+    sf::Vector2f currentCenter = m_center;
     sf::Vector2f desiredCenter = targetPosition;
     
-    // Lerp towards target
-    sf::Vector2f newCenter = currentCenter + (desiredCenter - currentCenter) * m_smoothing;
+    // Lerp towards target, scaled so the follow speed does not depend on the step length
+    float factor = 1.f - std::pow(1.f - m_smoothing, dt.asSeconds() * 60.f);
+    sf::Vector2f newCenter = currentCenter + (desiredCenter - currentCenter) * factor;
     
     // Clamp camera to world bounds
     sf::Vector2f viewSize = m_view.getSize();
@@ -29,7 +34,13 @@ void Camera::update(const sf::Vector2f& targetPosition)
     newCenter.y = std::max(m_worldBounds.position.y + halfHeight, 
                            std::min(newCenter.y, m_worldBounds.position.y + m_worldBounds.size.y - halfHeight));
     
-    m_view.setCenter(newCenter);
+    m_center = newCenter;
+    m_view.setCenter(m_center);
+}
+
+void Camera::interpolate(float alpha)
+{
+    m_view.setCenter(m_previousCenter + (m_center - m_previousCenter) * alpha);
 }
 
 void Camera::apply(sf::RenderWindow& window)
@@ -7,7 +7,12 @@ class Camera {
 public:
     Camera(const sf::Vector2f& viewSize, const sf::FloatRect& worldBounds);
     
-    void update(const sf::Vector2f& targetPosition);
+    // Advance one simulation step towards the target
+    void update(const sf::Vector2f& targetPosition, const sf::Time& dt);
+    
+    // Place the view between the last two simulated positions (alpha in [0, 1])
+    void interpolate(float alpha);
+    
     void apply(sf::RenderWindow& window);
     
     sf::View& getView() { return m_view; }
@@ -21,7 +26,10 @@ public:
 private:
     sf::View m_view;
     sf::FloatRect m_worldBounds;
-    float m_smoothing = 0.1f; // Camera smoothing factor (0 = instant, 1 = no movement)
+    float m_smoothing = 0.1f; // Share of the remaining distance covered every 1/60 s (1 = instant, 0 = no movement)
+    
+    sf::Vector2f m_center;
+    sf::Vector2f m_previousCenter;
 };
 
 } // namespace game::world
\ No newline at end of file
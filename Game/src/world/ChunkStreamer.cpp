@@ -0,0 +1,236 @@
+#include "ChunkStreamer.hpp"
+#include "../core/Profiler.hpp"
+#include "../core/Log.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+namespace game::world {
+
+ChunkStreamer::ChunkStreamer(unsigned int tilesPerChunk, std::size_t maxResidentChunks,
+                             const std::string& cacheDirectory, Generator generator)
+    : m_tilesPerChunk(tilesPerChunk)
+    , m_maxResidentChunks(std::max<std::size_t>(1, maxResidentChunks))
+    , m_cacheDirectory(cacheDirectory)
+    , m_generator(std::move(generator))
+{
+    // The cache is swap space for this session only, so leftovers from a previous world are cleared
+    std::error_code ec;
+    std::filesystem::create_directories(m_cacheDirectory, ec);
+    if (ec) {
+        GAME_LOG_ERROR("Failed to create chunk cache directory: " << m_cacheDirectory);
+    } else {
+        for (const auto& entry : std::filesystem::directory_iterator(m_cacheDirectory, ec)) {
+            if (entry.path().filename().string().rfind("chunk_", 0) == 0) {
+                std::filesystem::remove(entry.path(), ec);
+            }
+        }
+    }
+
+    m_worker = std::thread(&ChunkStreamer::workerLoop, this);
+}
+
+ChunkStreamer::~ChunkStreamer()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_condition.notify_all();
+    m_worker.join();
+}
+
+std::size_t ChunkStreamer::bytesPerChunk(unsigned int tilesPerChunk)
+{
+    return sizeof(ResidentChunk) + tilesPerChunk * sizeof(std::uint8_t);
+}
+
+void ChunkStreamer::request(const ChunkCoord& first, const ChunkCoord& last)
+{
+    m_focusFirst = first;
+    m_focusLast = last;
+
+    // Nearest chunks first so the middle of the screen fills in before the edges
+    ChunkCoord center{(first.x + last.x) / 2, (first.y + last.y) / 2};
+    std::vector<ChunkCoord> missing;
+    for (int y = first.y; y < last.y; ++y) {
+        for (int x = first.x; x < last.x; ++x) {
+            auto it = m_resident.find({x, y});
+            if (it != m_resident.end()) {
+                it->second.lastUsed = m_useCounter;
+            } else {
+                missing.push_back({x, y});
+            }
+        }
+    }
+    ++m_useCounter;
+
+    std::sort(missing.begin(), missing.end(), [&center](const ChunkCoord& a, const ChunkCoord& b) {
+        int da = std::abs(a.x - center.x) + std::abs(a.y - center.y);
+        int db = std::abs(b.x - center.x) + std::abs(b.y - center.y);
+        return da < db;
+    });
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // Forget work the camera has already moved away from
+        for (auto it = m_queue.begin(); it != m_queue.end(); ) {
+            if (!isInFocus(*it)) {
+                m_pending.erase(*it);
+                it = m_queue.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        for (const auto& coord : missing) {
+            if (m_pending.insert(coord).second) {
+                m_queue.push_back(coord);
+            }
+        }
+    }
+    m_condition.notify_one();
+}
+
+void ChunkStreamer::update()
+{
+    std::vector<std::pair<ChunkCoord, std::vector<std::uint8_t>>> completed;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        completed.swap(m_completed);
+    }
+
+    for (auto& [coord, tiles] : completed) {
+        // May already be resident if it was acquired synchronously in the meantime
+        if (m_resident.count(coord) || !isInFocus(coord)) continue;
+
+        ResidentChunk& chunk = m_resident[coord];
+        chunk.tiles = std::move(tiles);
+        chunk.lastUsed = m_useCounter;
+    }
+
+    evict();
+}
+
+ResidentChunk* ChunkStreamer::find(const ChunkCoord& coord)
+{
+    auto it = m_resident.find(coord);
+    if (it == m_resident.end()) return nullptr;
+
+    it->second.lastUsed = m_useCounter;
+    return &it->second;
+}
+
+ResidentChunk& ChunkStreamer::acquire(const ChunkCoord& coord)
+{
+    if (ResidentChunk* chunk = find(coord)) {
+        return *chunk;
+    }
+
+    ResidentChunk& chunk = m_resident[coord];
+    loadChunk(coord, chunk.tiles);
+    chunk.lastUsed = m_useCounter;
+    return chunk;
+}
+
+void ChunkStreamer::copyChunk(const ChunkCoord& coord, std::vector<std::uint8_t>& tiles) const
+{
+    auto it = m_resident.find(coord);
+    if (it != m_resident.end()) {
+        tiles = it->second.tiles;
+        return;
+    }
+    loadChunk(coord, tiles);
+}
+
+bool ChunkStreamer::isInFocus(const ChunkCoord& coord) const
+{
+    return coord.x >= m_focusFirst.x && coord.x < m_focusLast.x &&
+           coord.y >= m_focusFirst.y && coord.y < m_focusLast.y;
+}
+
+void ChunkStreamer::evict()
+{
+    if (m_resident.size() <= m_maxResidentChunks) return;
+
+    std::vector<std::pair<std::uint64_t, ChunkCoord>> candidates;
+    candidates.reserve(m_resident.size());
+    {
+        // A chunk the worker is still loading may be reading the cache file we would write
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& [coord, chunk] : m_resident) {
+            if (!isInFocus(coord) && !m_pending.count(coord)) {
+                candidates.push_back({chunk.lastUsed, coord});
+            }
+        }
+    }
+
+    // Oldest first
+    std::sort(candidates.begin(), candidates.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    for (const auto& [lastUsed, coord] : candidates) {
+        if (m_resident.size() <= m_maxResidentChunks) break;
+
+        auto it = m_resident.find(coord);
+        if (it->second.modified) {
+            saveChunk(coord, it->second.tiles);
+        }
+        m_resident.erase(it);
+    }
+}
+
+void ChunkStreamer::workerLoop()
+{
+    while (true) {
+        ChunkCoord coord;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+            if (m_stop) return;
+
+            coord = m_queue.front();
+            m_queue.pop_front();
+        }
+
+        std::vector<std::uint8_t> tiles;
+        {
+            GAME_PROFILE_ZONE("ChunkStreamer::load");
+            loadChunk(coord, tiles);
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.erase(coord);
+        m_completed.push_back({coord, std::move(tiles)});
+    }
+}
+
+void ChunkStreamer::loadChunk(const ChunkCoord& coord, std::vector<std::uint8_t>& tiles) const
+{
+    tiles.resize(m_tilesPerChunk);
+
+    // Chunks that were edited and paged out come back from disk, everything else is regenerated
+    std::ifstream file(getChunkPath(coord), std::ios::binary);
+    if (file && file.read(reinterpret_cast<char*>(tiles.data()), tiles.size())) {
+        return;
+    }
+
+    m_generator(coord, tiles);
+}
+
+void ChunkStreamer::saveChunk(const ChunkCoord& coord, const std::vector<std::uint8_t>& tiles) const
+{
+    std::ofstream file(getChunkPath(coord), std::ios::binary | std::ios::trunc);
+    if (!file.write(reinterpret_cast<const char*>(tiles.data()), tiles.size())) {
+        GAME_LOG_ERROR("Failed to write chunk " << coord.x << "," << coord.y << " to " << m_cacheDirectory);
+    }
+}
+
+std::string ChunkStreamer::getChunkPath(const ChunkCoord& coord) const
+{
+    return m_cacheDirectory + "/chunk_" + std::to_string(coord.x) + "_" + std::to_string(coord.y) + ".bin";
+}
+
+} // namespace game::world
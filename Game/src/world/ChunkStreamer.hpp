@@ -0,0 +1,105 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace game::world {
+
+struct ChunkCoord {
+    int x = 0;
+    int y = 0;
+
+    bool operator==(const ChunkCoord& other) const { return x == other.x && y == other.y; }
+};
+
+struct ChunkCoordHash {
+    std::size_t operator()(const ChunkCoord& c) const
+    {
+        return std::hash<std::uint64_t>()((static_cast<std::uint64_t>(static_cast<std::uint32_t>(c.x)) << 32) |
+                                          static_cast<std::uint32_t>(c.y));
+    }
+};
+
+// A chunk that is currently paged in
+struct ResidentChunk {
+    std::vector<std::uint8_t> tiles;   // Tile types, row-major, ChunkSize * ChunkSize
+    bool modified = false;             // Differs from generated data, written to disk on eviction
+    std::uint64_t lastUsed = 0;
+};
+
+// Pages world chunks in and out around a focus area.
+// Loading/generation runs on a background thread; the main thread picks up
+// finished chunks in update() and evicts the least recently used ones once
+// more than maxResidentChunks are paged in.
+class ChunkStreamer {
+public:
+    // Fills `tiles` for the given chunk. Called from the worker thread, so it must not touch shared state.
+    using Generator = std::function<void(ChunkCoord coord, std::vector<std::uint8_t>& tiles)>;
+
+    ChunkStreamer(unsigned int tilesPerChunk, std::size_t maxResidentChunks,
+                  const std::string& cacheDirectory, Generator generator);
+    ~ChunkStreamer();
+
+    ChunkStreamer(const ChunkStreamer&) = delete;
+    ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+
+    // Queue every chunk in [first, last) for background loading (nearest to the centre first)
+    // and drop queued work that is no longer inside the area
+    void request(const ChunkCoord& first, const ChunkCoord& last);
+
+    // Integrate finished loads and evict beyond the budget (call once per frame)
+    void update();
+
+    // Resident chunk or nullptr; does not trigger a load
+    ResidentChunk* find(const ChunkCoord& coord);
+
+    // Resident chunk, loading it synchronously if needed
+    ResidentChunk& acquire(const ChunkCoord& coord);
+
+    // Copy of a chunk's tiles without making it resident (for saving whole maps)
+    void copyChunk(const ChunkCoord& coord, std::vector<std::uint8_t>& tiles) const;
+
+    std::size_t getResidentCount() const { return m_resident.size(); }
+    std::size_t getMaxResidentChunks() const { return m_maxResidentChunks; }
+
+    // Rough resident cost of one chunk
+    static std::size_t bytesPerChunk(unsigned int tilesPerChunk);
+
+private:
+    void workerLoop();
+    void loadChunk(const ChunkCoord& coord, std::vector<std::uint8_t>& tiles) const;
+    void saveChunk(const ChunkCoord& coord, const std::vector<std::uint8_t>& tiles) const;
+    std::string getChunkPath(const ChunkCoord& coord) const;
+    bool isInFocus(const ChunkCoord& coord) const;
+    void evict();
+
+    unsigned int m_tilesPerChunk;
+    std::size_t m_maxResidentChunks;
+    std::string m_cacheDirectory;
+    Generator m_generator;
+
+    // Main thread only
+    std::unordered_map<ChunkCoord, ResidentChunk, ChunkCoordHash> m_resident;
+    ChunkCoord m_focusFirst;
+    ChunkCoord m_focusLast;
+    std::uint64_t m_useCounter = 0;
+
+    // Shared with the worker, guarded by m_mutex
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<ChunkCoord> m_queue;
+    std::unordered_set<ChunkCoord, ChunkCoordHash> m_pending;
+    std::vector<std::pair<ChunkCoord, std::vector<std::uint8_t>>> m_completed;
+    bool m_stop = false;
+
+    std::thread m_worker;
+};
+
+} // namespace game::world
@@ -0,0 +1,257 @@
+#include "MapFile.hpp"
+#include "../core/Log.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace game::world {
+
+namespace {
+
+const char Magic[4] = {'G', 'M', 'A', 'P'};
+
+// Run-length encode as (count, value) pairs; returns false if it would not be smaller than raw
+bool encodeRunLength(const std::vector<std::uint8_t>& tiles, std::vector<std::uint8_t>& out)
+{
+    out.clear();
+    for (std::size_t i = 0; i < tiles.size(); ) {
+        std::uint8_t value = tiles[i];
+        std::size_t run = 1;
+        while (i + run < tiles.size() && tiles[i + run] == value && run < 255) {
+            ++run;
+        }
+        out.push_back(static_cast<std::uint8_t>(run));
+        out.push_back(value);
+        i += run;
+
+        if (out.size() >= tiles.size()) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+MapFile::~MapFile()
+{
+    close();
+}
+
+bool MapFile::open(const std::string& path)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        GAME_LOG_ERROR("Failed to open map: " << path);
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(file, &fileSize);
+    HANDLE mapping = fileSize.QuadPart > 0 ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+    CloseHandle(file);
+    if (!mapping) {
+        GAME_LOG_ERROR("Failed to map map file: " << path);
+        return false;
+    }
+
+    // The view keeps the mapping alive on its own
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view) {
+        GAME_LOG_ERROR("Failed to map map file: " << path);
+        return false;
+    }
+
+    m_data = static_cast<const std::uint8_t*>(view);
+    m_size = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        GAME_LOG_ERROR("Failed to open map: " << path);
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        GAME_LOG_ERROR("Failed to read map: " << path);
+        return false;
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    void* view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        GAME_LOG_ERROR("Failed to map map file: " << path);
+        return false;
+    }
+
+    m_data = static_cast<const std::uint8_t*>(view);
+    m_size = static_cast<std::size_t>(info.st_size);
+#endif
+
+    if (m_size < sizeof(MapHeader)) {
+        GAME_LOG_ERROR("Map file is truncated: " << path);
+        close();
+        return false;
+    }
+
+    std::memcpy(&m_header, m_data, sizeof(MapHeader));
+    if (std::memcmp(m_header.magic, Magic, sizeof(Magic)) != 0 || m_header.version != Version ||
+        m_header.chunkSize == 0) {
+        GAME_LOG_ERROR("Not a supported map file (version " << m_header.version << "): " << path);
+        close();
+        return false;
+    }
+
+    m_chunksX = (m_header.width + m_header.chunkSize - 1) / m_header.chunkSize;
+    m_chunksY = (m_header.height + m_header.chunkSize - 1) / m_header.chunkSize;
+
+    std::size_t indexBytes = static_cast<std::size_t>(m_chunksX) * m_chunksY * sizeof(ChunkIndexEntry);
+    if (m_size < sizeof(MapHeader) + indexBytes) {
+        GAME_LOG_ERROR("Map file is truncated: " << path);
+        close();
+        return false;
+    }
+
+    m_index = reinterpret_cast<const ChunkIndexEntry*>(m_data + sizeof(MapHeader));
+
+    GAME_LOG_INFO("Map opened: " << path << " (" << m_header.width << "x" << m_header.height << " tiles)");
+    return true;
+}
+
+void MapFile::close()
+{
+    if (!m_data) return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(m_data);
+#else
+    munmap(const_cast<std::uint8_t*>(m_data), m_size);
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+    m_index = nullptr;
+}
+
+bool MapFile::decodeChunk(const ChunkCoord& coord, std::uint8_t* tiles) const
+{
+    if (!m_data || coord.x < 0 || coord.y < 0 ||
+        static_cast<std::uint32_t>(coord.x) >= m_chunksX || static_cast<std::uint32_t>(coord.y) >= m_chunksY) {
+        return false;
+    }
+
+    const ChunkIndexEntry& entry = m_index[coord.x + static_cast<std::size_t>(coord.y) * m_chunksX];
+    if (entry.offset > m_size || entry.size > m_size - entry.offset) {
+        return false;
+    }
+
+    const std::uint8_t* payload = m_data + entry.offset;
+    const std::size_t tileCount = static_cast<std::size_t>(m_header.chunkSize) * m_header.chunkSize;
+
+    switch (static_cast<ChunkEncoding>(entry.encoding)) {
+        case ChunkEncoding::Raw:
+            if (entry.size != tileCount) return false;
+            std::memcpy(tiles, payload, tileCount);
+            return true;
+
+        case ChunkEncoding::RunLength: {
+            std::size_t written = 0;
+            for (std::uint32_t i = 0; i + 1 < entry.size; i += 2) {
+                std::size_t run = std::min<std::size_t>(payload[i], tileCount - written);
+                std::memset(tiles + written, payload[i + 1], run);
+                written += run;
+            }
+            return written == tileCount;
+        }
+    }
+
+    return false;
+}
+
+bool MapFile::write(const std::string& path, const MapHeader& header, const ChunkSource& source)
+{
+    // `path` may be the map `source` is reading from (and that is memory-mapped), so write
+    // beside it and swap the finished file in; existing mappings keep the old contents
+    const std::string tempPath = path + ".tmp";
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        GAME_LOG_ERROR("Failed to create map: " << tempPath);
+        return false;
+    }
+
+    std::uint32_t chunksX = (header.width + header.chunkSize - 1) / header.chunkSize;
+    std::uint32_t chunksY = (header.height + header.chunkSize - 1) / header.chunkSize;
+
+    MapHeader out = header;
+    std::memcpy(out.magic, Magic, sizeof(Magic));
+    out.version = Version;
+
+    // Payloads follow the index, which is written last once the offsets are known
+    std::vector<ChunkIndexEntry> index(static_cast<std::size_t>(chunksX) * chunksY);
+    std::uint64_t offset = sizeof(MapHeader) + index.size() * sizeof(ChunkIndexEntry);
+    file.seekp(static_cast<std::streamoff>(offset));
+
+    std::vector<std::uint8_t> tiles(static_cast<std::size_t>(header.chunkSize) * header.chunkSize);
+    std::vector<std::uint8_t> encoded;
+
+    for (std::uint32_t cy = 0; cy < chunksY; ++cy) {
+        for (std::uint32_t cx = 0; cx < chunksX; ++cx) {
+            source({static_cast<int>(cx), static_cast<int>(cy)}, tiles);
+
+            ChunkIndexEntry& entry = index[cx + static_cast<std::size_t>(cy) * chunksX];
+            entry.offset = offset;
+
+            if (encodeRunLength(tiles, encoded)) {
+                entry.encoding = static_cast<std::uint32_t>(ChunkEncoding::RunLength);
+                entry.size = static_cast<std::uint32_t>(encoded.size());
+                file.write(reinterpret_cast<const char*>(encoded.data()), encoded.size());
+            } else {
+                entry.encoding = static_cast<std::uint32_t>(ChunkEncoding::Raw);
+                entry.size = static_cast<std::uint32_t>(tiles.size());
+                file.write(reinterpret_cast<const char*>(tiles.data()), tiles.size());
+            }
+            offset += entry.size;
+        }
+    }
+
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&out), sizeof(out));
+    file.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(ChunkIndexEntry));
+
+    file.close();
+    std::error_code ec;
+    if (!file) {
+        GAME_LOG_ERROR("Failed to write map: " << tempPath);
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        GAME_LOG_ERROR("Failed to replace map " << path << ": " << ec.message());
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    GAME_LOG_INFO("Map saved: " << path << " (" << offset << " bytes)");
+    return true;
+}
+
+} // namespace game::world
@@ -0,0 +1,75 @@
+#pragma once
+#include "ChunkStreamer.hpp"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace game::world {
+
+// On-disk map layout (little-endian):
+//   MapHeader
+//   ChunkIndexEntry[chunksX * chunksY]   row-major, one per chunk
+//   chunk payloads                       raw or run-length encoded tile type bytes
+struct MapHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t width;       // In tiles
+    std::uint32_t height;
+    std::uint32_t chunkSize;   // Tiles per chunk side
+    float tileSize;
+    std::uint64_t seed;
+};
+
+struct ChunkIndexEntry {
+    std::uint64_t offset;      // From the start of the file
+    std::uint32_t size;        // Payload bytes
+    std::uint32_t encoding;    // ChunkEncoding
+};
+
+enum class ChunkEncoding : std::uint32_t {
+    Raw,                       // chunkSize * chunkSize type bytes
+    RunLength                  // (count, type) byte pairs
+};
+
+static_assert(sizeof(MapHeader) == 32, "MapHeader layout is part of the file format");
+static_assert(sizeof(ChunkIndexEntry) == 16, "ChunkIndexEntry layout is part of the file format");
+
+// Read-only view of a map file. The file is memory-mapped and chunks are only
+// decoded when asked for, so opening a huge map touches just the header and index.
+class MapFile {
+public:
+    static constexpr std::uint32_t Version = 1;
+
+    // Supplies the tiles of one chunk (chunkSize * chunkSize bytes, row-major) when saving
+    using ChunkSource = std::function<void(const ChunkCoord& coord, std::vector<std::uint8_t>& tiles)>;
+
+    MapFile() = default;
+    ~MapFile();
+
+    MapFile(const MapFile&) = delete;
+    MapFile& operator=(const MapFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    const MapHeader& getHeader() const { return m_header; }
+
+    // Fills chunkSize * chunkSize bytes; safe to call from several threads at once
+    bool decodeChunk(const ChunkCoord& coord, std::uint8_t* tiles) const;
+
+    // Writes to a temporary file and renames it over `path`, so saving over a map that is
+    // open (and being read by `source`) is safe
+    static bool write(const std::string& path, const MapHeader& header, const ChunkSource& source);
+
+private:
+    const std::uint8_t* m_data = nullptr;
+    std::size_t m_size = 0;
+
+    MapHeader m_header{};
+    const ChunkIndexEntry* m_index = nullptr;
+    std::uint32_t m_chunksX = 0;
+    std::uint32_t m_chunksY = 0;
+};
+
+} // namespace game::world
@@ -0,0 +1,72 @@
+#include "SpatialHash.hpp"
+
+namespace game::world {
+
+SpatialHash::SpatialHash(float cellSize)
+    : m_cellSize(cellSize)
+{
+}
+
+void SpatialHash::clear()
+{
+    m_items.clear();
+    m_unsorted.clear();
+    m_dirty = true;
+}
+
+void SpatialHash::insert(std::uint32_t id, std::uint32_t category, const sf::FloatRect& bounds)
+{
+    Item item;
+    item.bounds = bounds;
+    item.id = id;
+    item.category = category;
+    item.firstX = static_cast<int>(std::floor(bounds.position.x / m_cellSize));
+    item.firstY = static_cast<int>(std::floor(bounds.position.y / m_cellSize));
+    item.lastX = static_cast<int>(std::floor((bounds.position.x + bounds.size.x) / m_cellSize));
+    item.lastY = static_cast<int>(std::floor((bounds.position.y + bounds.size.y) / m_cellSize));
+
+    auto index = static_cast<std::uint32_t>(m_items.size());
+    for (int y = item.firstY; y <= item.lastY; ++y) {
+        for (int x = item.firstX; x <= item.lastX; ++x) {
+            m_unsorted.push_back({cellKey(x, y), index});
+        }
+    }
+
+    m_items.push_back(item);
+    m_dirty = true;
+}
+
+void SpatialHash::build() const
+{
+    // About two buckets per entry keeps chains short
+    std::size_t buckets = 1;
+    while (buckets < m_unsorted.size() * 2) {
+        buckets <<= 1;
+    }
+
+    m_bucketStart.assign(buckets + 1, 0);
+    m_entries.resize(m_unsorted.size());
+
+    // Counting sort by bucket: count, prefix sum, scatter
+    for (const CellEntry& entry : m_unsorted) {
+        ++m_bucketStart[bucketOf(entry.key) + 1];
+    }
+    for (std::size_t b = 1; b <= buckets; ++b) {
+        m_bucketStart[b] += m_bucketStart[b - 1];
+    }
+
+    for (const CellEntry& entry : m_unsorted) {
+        // m_bucketStart[b] is bucket b's write cursor and ends up at the start of bucket b + 1
+        m_entries[m_bucketStart[bucketOf(entry.key)]++] = entry;
+    }
+
+    // Shift the cursors back so m_bucketStart[b] is the start of bucket b again
+    for (std::size_t b = buckets; b > 0; --b) {
+        m_bucketStart[b] = m_bucketStart[b - 1];
+    }
+    m_bucketStart[0] = 0;
+
+    m_dirty = false;
+}
+
+} // namespace game::world
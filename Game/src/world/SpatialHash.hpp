@@ -0,0 +1,115 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace game::world {
+
+// What an entry is, so one grid can hold everything and queries can filter. Plain bit flags
+// (combine with |), scoped in a struct so the names stay out of game::world.
+struct SpatialCategory {
+    enum : std::uint32_t {
+        Player     = 1u << 0,
+        Enemy      = 1u << 1,
+        Projectile = 1u << 2
+    };
+};
+
+// Uniform grid broadphase, rebuilt every frame: clear(), insert() everything
+// that moved, then query(). Cells are hashed into a flat table sized to the
+// entry count and filled with a counting sort, so a rebuild is O(n) and no
+// memory is allocated once the buffers have grown to their working size.
+class SpatialHash {
+public:
+    explicit SpatialHash(float cellSize);
+
+    void clear();
+
+    // `id` is handed back by query(); it is typically an index into the caller's own array
+    void insert(std::uint32_t id, std::uint32_t category, const sf::FloatRect& bounds);
+
+    // Calls fn(id) once for every entry in `categories` whose bounds overlap `area`
+    template <typename Fn>
+    void query(const sf::FloatRect& area, std::uint32_t categories, Fn&& fn) const;
+
+    float getCellSize() const { return m_cellSize; }
+    std::size_t getEntryCount() const { return m_items.size(); }
+
+private:
+    struct Item {
+        sf::FloatRect bounds;
+        std::uint32_t id;
+        std::uint32_t category;
+        int firstX, firstY;     // Cell range covered by the bounds
+        int lastX, lastY;
+    };
+
+    struct CellEntry {
+        std::uint64_t key;
+        std::uint32_t item;
+    };
+
+    static std::uint64_t cellKey(int x, int y)
+    {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+    }
+
+    std::size_t bucketOf(std::uint64_t key) const
+    {
+        key *= 0x9E3779B97F4A7C15ull;
+        return static_cast<std::size_t>(key >> 32) & (m_bucketStart.size() - 2);
+    }
+
+    static bool overlaps(const sf::FloatRect& a, const sf::FloatRect& b)
+    {
+        return a.position.x < b.position.x + b.size.x && b.position.x < a.position.x + a.size.x &&
+               a.position.y < b.position.y + b.size.y && b.position.y < a.position.y + a.size.y;
+    }
+
+    void build() const;
+
+    float m_cellSize;
+    std::vector<Item> m_items;
+    std::vector<CellEntry> m_unsorted;
+
+    // Built lazily on the first query after a change
+    mutable std::vector<CellEntry> m_entries;        // Grouped by bucket
+    mutable std::vector<std::uint32_t> m_bucketStart; // Power-of-two bucket count + 1
+    mutable bool m_dirty = false;
+};
+
+template <typename Fn>
+void SpatialHash::query(const sf::FloatRect& area, std::uint32_t categories, Fn&& fn) const
+{
+    if (m_items.empty()) return;
+    if (m_dirty) build();
+
+    int firstX = static_cast<int>(std::floor(area.position.x / m_cellSize));
+    int firstY = static_cast<int>(std::floor(area.position.y / m_cellSize));
+    int lastX = static_cast<int>(std::floor((area.position.x + area.size.x) / m_cellSize));
+    int lastY = static_cast<int>(std::floor((area.position.y + area.size.y) / m_cellSize));
+
+    for (int y = firstY; y <= lastY; ++y) {
+        for (int x = firstX; x <= lastX; ++x) {
+            std::uint64_t key = cellKey(x, y);
+            std::size_t bucket = bucketOf(key);
+
+            for (std::uint32_t i = m_bucketStart[bucket]; i < m_bucketStart[bucket + 1]; ++i) {
+                if (m_entries[i].key != key) continue;
+
+                const Item& item = m_items[m_entries[i].item];
+                if (!(item.category & categories)) continue;
+
+                // An item spanning several cells is reported only from the first cell it shares with the query
+                if (x != std::max(item.firstX, firstX) || y != std::max(item.firstY, firstY)) continue;
+
+                if (overlaps(item.bounds, area)) {
+                    fn(item.id);
+                }
+            }
+        }
+    }
+}
+
+} // namespace game::world
@@ -0,0 +1,14 @@
+#pragma once
+#include <cstdint>
+
+namespace game::world {
+
+enum class TileType : std::uint8_t {
+    Grass,
+    Water,
+    Stone,
+    Sand,
+    Wall
+};
+
+} // namespace game::world
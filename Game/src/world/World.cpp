@@ -1,6 +1,11 @@
 #include "World.hpp"
+#include "../core/Profiler.hpp"
+#include "../core/ThreadPool.hpp"
+#include "../core/Log.hpp"
 #include <random>
-#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace game::world {
 
@@ -8,47 +13,49 @@ World::World(unsigned int width, unsigned int height, float tileSize)
     : m_width(width)
     , m_height(height)
     , m_tileSize(tileSize)
+    , m_seed((static_cast<std::uint64_t>(std::random_device{}()) << 32) | std::random_device{}())
+    , m_generator(m_seed, width, height)
 {
     m_worldBounds = sf::FloatRect(
         sf::Vector2f(0.f, 0.f),
         sf::Vector2f(width * tileSize, height * tileSize)
     );
     
-    m_tiles.resize(m_height);
-    for (auto& row : m_tiles) {
-        row.resize(m_width);
-    }
+    std::size_t tileCount = static_cast<std::size_t>(m_width) * m_height;
+    m_tileTypes.resize(tileCount);
+    m_walkable.resize((tileCount + 63) / 64);
 }
 
-bool World::loadBackgroundTexture(const std::string& texturePath)
+bool World::loadBackgroundTexture(game::assets::AssetManager& assets, const std::string& texturePath)
 {
-    if (!m_backgroundTexture.loadFromFile(texturePath)) {
-        std::cerr << "Failed to load background texture: " << texturePath << "\n";
-        std::cerr << "Creating fallback background...\n";
+    m_backgroundTexture = assets.loadTexture(texturePath);
+    assets.finish(m_backgroundTexture);
+    if (!m_backgroundTexture.isReady()) {
+        GAME_LOG_WARN("Creating fallback background...");
         
         // Create simple colored background as fallback
         sf::Image bgImage({100, 100}, sf::Color(34, 139, 34)); // Green
-        if (!m_backgroundTexture.loadFromImage(bgImage)) {
-            std::cerr << "Failed to create fallback background\n";
+        m_backgroundTexture = assets.addTexture("fallback:background", bgImage);
+        if (!m_backgroundTexture.isReady()) {
+            GAME_LOG_ERROR("Failed to create fallback background");
             return false;
         }
-    } else {
-        std::cout << "Background texture loaded: " << texturePath << "\n";
     }
     
-    m_backgroundTexture.setRepeated(true);
+    m_backgroundTexture->setRepeated(true);
     m_hasBackground = true;
     buildBackgroundVertices();
     return true;
 }
 
-bool World::loadTileset(const std::string& texturePath, const sf::Vector2i& tileSize)
+bool World::loadTileset(game::assets::AssetManager& assets, const std::string& texturePath, const sf::Vector2i& tileSize)
 {
     m_tilesetTileSize = tileSize;
     
-    if (!m_tilesetTexture.loadFromFile(texturePath)) {
-        std::cerr << "Failed to load tileset: " << texturePath << "\n";
-        std::cerr << "Creating fallback tileset...\n";
+    m_tilesetTexture = assets.loadTexture(texturePath);
+    assets.finish(m_tilesetTexture);
+    if (!m_tilesetTexture.isReady()) {
+        GAME_LOG_WARN("Creating fallback tileset...");
         
         // Create simple placeholder tileset (5 tiles in a row for our 5 tile types)
         int tileCount = 5;
@@ -68,23 +75,24 @@ bool World::loadTileset(const std::string& texturePath, const sf::Vector2i& tile
             }
         }
         
-        if (!m_tilesetTexture.loadFromImage(tilesetImage)) {
-            std::cerr << "Failed to create fallback tileset\n";
+        m_tilesetTexture = assets.addTexture("fallback:tileset", tilesetImage);
+        if (!m_tilesetTexture.isReady()) {
+            GAME_LOG_ERROR("Failed to create fallback tileset");
             return false;
         }
-    } else {
-        std::cout << "Tileset loaded: " << texturePath << "\n";
     }
     
-    sf::Vector2u texSize = m_tilesetTexture.getSize();
+    sf::Vector2u texSize = m_tilesetTexture->getSize();
     m_tilesPerRow = texSize.x / tileSize.x;
     
-    std::cout << "Tileset: " << texSize.x << "x" << texSize.y 
-              << " | Tile size: " << tileSize.x << "x" << tileSize.y
-              << " | Tiles per row: " << m_tilesPerRow << "\n";
+    GAME_LOG_INFO("Tileset: " << texSize.x << "x" << texSize.y 
+                  << " | Tile size: " << tileSize.x << "x" << tileSize.y
+                  << " | Tiles per row: " << m_tilesPerRow);
     
     m_hasTileset = true;
-    buildTileVertices();
+    
+    // Cached meshes were built without (or with another) tileset
+    m_meshCache.clear();
     return true;
 }
 
@@ -99,7 +107,7 @@ void World::buildBackgroundVertices()
     float worldHeight = m_height * m_tileSize;
     
     // Get texture size for proper UV mapping (repeating texture)
-    sf::Vector2u texSize = m_backgroundTexture.getSize();
+    sf::Vector2u texSize = m_backgroundTexture->getSize();
     float uMax = worldWidth / texSize.x;
     float vMax = worldHeight / texSize.y;
     
@@ -124,53 +132,101 @@ void World::buildBackgroundVertices()
     m_backgroundVertices[5].texCoords = sf::Vector2f(uMax, vMax);
 }
 
-void World::buildTileVertices()
+void World::buildChunkMesh(const ChunkCoord& coord, const std::uint8_t* tiles, unsigned int stride, ChunkMesh& mesh) const
 {
-    if (!m_hasTileset) return;
+    // `tiles` points at the chunk's top-left tile, rows are `stride` bytes apart
+    unsigned int startX = coord.x * ChunkSize;
+    unsigned int startY = coord.y * ChunkSize;
+    unsigned int endX = std::min(startX + ChunkSize, m_width);
+    unsigned int endY = std::min(startY + ChunkSize, m_height);
+    unsigned int chunkWidth = endX - startX;
     
-    m_tileVertices.setPrimitiveType(sf::PrimitiveType::Triangles);
-    m_tileVertices.resize(m_width * m_height * 6);
+    mesh.vertices.setPrimitiveType(sf::PrimitiveType::Triangles);
+    mesh.vertices.resize(chunkWidth * (endY - startY) * 6);
     
-    for (unsigned int y = 0; y < m_height; ++y) {
-        for (unsigned int x = 0; x < m_width; ++x) {
-            int tileIndex = getTileTextureIndex(m_tiles[y][x].type);
-            
-            // Calculate tile position in tileset texture
-            int tu = tileIndex % m_tilesPerRow;
-            int tv = tileIndex / m_tilesPerRow;
-            
-            // Get vertex pointer for this tile's quad
-            sf::Vertex* quad = &m_tileVertices[(x + y * m_width) * 6];
-            
-            // Position in world
-            float px = x * m_tileSize;
-            float py = y * m_tileSize;
-            
-            // Position in tileset texture
-            float tx = tu * m_tilesetTileSize.x;
-            float ty = tv * m_tilesetTileSize.y;
-            
-            // Triangle 1
-            quad[0].position = sf::Vector2f(px, py);
-            quad[0].texCoords = sf::Vector2f(tx, ty);
-            
-            quad[1].position = sf::Vector2f(px + m_tileSize, py);
-            quad[1].texCoords = sf::Vector2f(tx + m_tilesetTileSize.x, ty);
-            
-            quad[2].position = sf::Vector2f(px, py + m_tileSize);
-            quad[2].texCoords = sf::Vector2f(tx, ty + m_tilesetTileSize.y);
-            
-            // Triangle 2
-            quad[3].position = sf::Vector2f(px, py + m_tileSize);
-            quad[3].texCoords = sf::Vector2f(tx, ty + m_tilesetTileSize.y);
-            
-            quad[4].position = sf::Vector2f(px + m_tileSize, py);
-            quad[4].texCoords = sf::Vector2f(tx + m_tilesetTileSize.x, ty);
-            
-            quad[5].position = sf::Vector2f(px + m_tileSize, py + m_tileSize);
-            quad[5].texCoords = sf::Vector2f(tx + m_tilesetTileSize.x, ty + m_tilesetTileSize.y);
+    for (unsigned int y = startY; y < endY; ++y) {
+        const std::uint8_t* row = tiles + (y - startY) * stride;
+        for (unsigned int x = startX; x < endX; ++x) {
+            // Get vertex pointer for this tile's quad (indices are local to the chunk)
+            sf::Vertex* quad = &mesh.vertices[((x - startX) + (y - startY) * chunkWidth) * 6];
+            writeTileQuad(quad, x, y, static_cast<TileType>(row[x - startX]));
         }
     }
+    
+    mesh.dirty = false;
+}
+
+void World::pruneMeshCache() const
+{
+    if (m_meshCache.size() <= MaxCachedMeshes) return;
+    
+    // Drop everything that was not on screen this frame
+    for (auto it = m_meshCache.begin(); it != m_meshCache.end(); ) {
+        if (it->second.lastDrawn != m_drawCounter) {
+            it = m_meshCache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void World::writeTileQuad(sf::Vertex* quad, unsigned int x, unsigned int y, TileType type) const
+{
+    // Position in world
+    float px = x * m_tileSize;
+    float py = y * m_tileSize;
+    
+    quad[0].position = sf::Vector2f(px, py);
+    quad[1].position = sf::Vector2f(px + m_tileSize, py);
+    quad[2].position = sf::Vector2f(px, py + m_tileSize);
+    quad[3].position = sf::Vector2f(px, py + m_tileSize);
+    quad[4].position = sf::Vector2f(px + m_tileSize, py);
+    quad[5].position = sf::Vector2f(px + m_tileSize, py + m_tileSize);
+    
+    // Without a tileset the quad is just tinted with the tile colour
+    if (!m_hasTileset) {
+        sf::Color color = getTileColor(type);
+        for (int i = 0; i < 6; ++i) {
+            quad[i].color = color;
+        }
+        return;
+    }
+    
+    int tileIndex = getTileTextureIndex(type);
+    
+    // Calculate tile position in tileset texture
+    int tu = tileIndex % m_tilesPerRow;
+    int tv = tileIndex / m_tilesPerRow;
+    
+    // Position in tileset texture
+    float tx = tu * m_tilesetTileSize.x;
+    float ty = tv * m_tilesetTileSize.y;
+    
+    for (int i = 0; i < 6; ++i) {
+        quad[i].color = sf::Color::White;
+    }
+    
+    // Triangle 1
+    quad[0].texCoords = sf::Vector2f(tx, ty);
+    quad[1].texCoords = sf::Vector2f(tx + m_tilesetTileSize.x, ty);
+    quad[2].texCoords = sf::Vector2f(tx, ty + m_tilesetTileSize.y);
+    
+    // Triangle 2
+    quad[3].texCoords = sf::Vector2f(tx, ty + m_tilesetTileSize.y);
+    quad[4].texCoords = sf::Vector2f(tx + m_tilesetTileSize.x, ty);
+    quad[5].texCoords = sf::Vector2f(tx + m_tilesetTileSize.x, ty + m_tilesetTileSize.y);
+}
+
+void World::getChunkRange(const sf::FloatRect& viewBounds, int margin, ChunkCoord& first, ChunkCoord& last) const
+{
+    const float chunkWorldSize = ChunkSize * m_tileSize;
+    int chunksX = static_cast<int>((m_width + ChunkSize - 1) / ChunkSize);
+    int chunksY = static_cast<int>((m_height + ChunkSize - 1) / ChunkSize);
+    
+    first.x = std::max(0, static_cast<int>(std::floor(viewBounds.position.x / chunkWorldSize)) - margin);
+    first.y = std::max(0, static_cast<int>(std::floor(viewBounds.position.y / chunkWorldSize)) - margin);
+    last.x = std::min(chunksX, static_cast<int>((viewBounds.position.x + viewBounds.size.x) / chunkWorldSize) + 1 + margin);
+    last.y = std::min(chunksY, static_cast<int>((viewBounds.position.y + viewBounds.size.y) / chunkWorldSize) + 1 + margin);
 }
 
 int World::getTileTextureIndex(TileType type) const
@@ -187,115 +243,406 @@ int World::getTileTextureIndex(TileType type) const
     }
 }
 
-void World::generate()
+void World::setSeed(std::uint64_t seed)
 {
-    std::cout << "Generating world: " << m_width << "x" << m_height << " tiles\n";
+    m_seed = seed;
+    m_generator = WorldGenerator(seed, m_width, m_height);
+}
+
+void World::generate(unsigned int threadCount)
+{
+    if (m_streamer) {
+        GAME_LOG_INFO("Streaming world: chunks are generated as the camera approaches");
+        return;
+    }
     
-    std::mt19937 gen(std::random_device{}());
-    std::uniform_int_distribution<int> dist(0, 100);
+    GAME_LOG_INFO("Generating world: " << m_width << "x" << m_height << " tiles (seed " << m_seed << ")");
     
-    for (unsigned int y = 0; y < m_height; ++y) {
-        for (unsigned int x = 0; x < m_width; ++x) {
-            Tile& tile = m_tiles[y][x];
-            
-            // Create borders (walls)
-            if (x == 0 || y == 0 || x == m_width - 1 || y == m_height - 1) {
-                tile.type = TileType::Wall;
-            }
-            // Random terrain in the middle
-            else {
-                int rand = dist(gen);
-                if (rand < 5) {
-                    tile.type = TileType::Water;
-                } else if (rand < 10) {
-                    tile.type = TileType::Stone;
-                } else if (rand < 15) {
-                    tile.type = TileType::Sand;
-                } else {
-                    tile.type = TileType::Grass;
-                }
+    core::ThreadPool pool(threadCount);
+    m_generator.generate(m_tileTypes.data(), ChunkSize, pool);
+    
+    // Walkability bits in blocks of whole 64-bit words so no two threads write the same word
+    const std::size_t wordsPerBlock = 1024;
+    const std::size_t tileCount = m_tileTypes.size();
+    pool.parallelFor((m_walkable.size() + wordsPerBlock - 1) / wordsPerBlock, [&](std::size_t block) {
+        std::size_t firstWord = block * wordsPerBlock;
+        std::size_t lastWord = std::min(firstWord + wordsPerBlock, m_walkable.size());
+        
+        for (std::size_t w = firstWord; w < lastWord; ++w) {
+            std::uint64_t bits = 0;
+            std::size_t end = std::min(tileCount, (w + 1) * 64);
+            for (std::size_t i = w * 64; i < end; ++i) {
+                bits |= static_cast<std::uint64_t>(isTileWalkable(static_cast<TileType>(m_tileTypes[i]))) << (i & 63);
             }
-            
-            tile.walkable = isTileWalkable(tile.type);
-            tile.shape.setSize(sf::Vector2f(m_tileSize, m_tileSize));
-            tile.shape.setPosition(sf::Vector2f(x * m_tileSize, y * m_tileSize));
-            tile.shape.setFillColor(getTileColor(tile.type));
-            tile.shape.setOutlineColor(sf::Color(0, 0, 0, 50));
-            tile.shape.setOutlineThickness(1.f);
+            m_walkable[w] = bits;
+        }
+    });
+    
+    m_meshCache.clear();
+    
+    GAME_LOG_INFO("World generated successfully!");
+}
+
+void World::generateChunk(const ChunkCoord& coord, std::vector<std::uint8_t>& tiles) const
+{
+    m_generator.generateChunk(coord.x, coord.y, ChunkSize, tiles.data(), ChunkSize);
+}
+
+void World::enableStreaming(const StreamingSettings& settings)
+{
+    m_streamingSettings = settings;
+    startStreaming([this](ChunkCoord coord, std::vector<std::uint8_t>& tiles) { generateChunk(coord, tiles); });
+}
+
+void World::startStreaming(ChunkStreamer::Generator source)
+{
+    // Stop the old worker before anything it reads changes
+    m_streamer.reset();
+    
+    std::size_t maxChunks = m_streamingSettings.memoryBudget / ChunkStreamer::bytesPerChunk(ChunkSize * ChunkSize);
+    m_streamer = std::make_unique<ChunkStreamer>(
+        ChunkSize * ChunkSize, maxChunks, m_streamingSettings.cacheDirectory, std::move(source)
+    );
+    
+    // The whole-map storage is no longer needed
+    std::vector<std::uint8_t>().swap(m_tileTypes);
+    std::vector<std::uint64_t>().swap(m_walkable);
+    m_meshCache.clear();
+    
+    GAME_LOG_INFO("World streaming enabled: " << maxChunks << " resident chunks max");
+}
+
+bool World::save(const std::string& path) const
+{
+    MapHeader header{};
+    header.width = m_width;
+    header.height = m_height;
+    header.chunkSize = ChunkSize;
+    header.tileSize = m_tileSize;
+    header.seed = m_seed;
+    
+    return MapFile::write(path, header, [this](const ChunkCoord& coord, std::vector<std::uint8_t>& tiles) {
+        if (m_streamer) {
+            m_streamer->copyChunk(coord, tiles);
+            return;
+        }
+        
+        // Tiles past the map edge are padding and saved as grass
+        std::fill(tiles.begin(), tiles.end(), static_cast<std::uint8_t>(TileType::Grass));
+        unsigned int startX = coord.x * ChunkSize;
+        unsigned int startY = coord.y * ChunkSize;
+        unsigned int endX = std::min(startX + ChunkSize, m_width);
+        unsigned int endY = std::min(startY + ChunkSize, m_height);
+        
+        for (unsigned int y = startY; y < endY; ++y) {
+            std::copy_n(&m_tileTypes[startX + static_cast<std::size_t>(y) * m_width], endX - startX,
+                        &tiles[(y - startY) * ChunkSize]);
         }
+    });
+}
+
+bool World::load(const std::string& path)
+{
+    auto mapFile = std::make_unique<MapFile>();
+    if (!mapFile->open(path)) {
+        return false;
     }
     
-    // Build tile vertices if tileset is loaded
-    if (m_hasTileset) {
-        buildTileVertices();
+    const MapHeader& header = mapFile->getHeader();
+    if (header.chunkSize != ChunkSize) {
+        GAME_LOG_ERROR("Map chunk size " << header.chunkSize << " does not match " << ChunkSize << ": " << path);
+        return false;
+    }
+    
+    // The old streamer may still be decoding from the previous map
+    m_streamer.reset();
+    m_mapFile = std::move(mapFile);
+    
+    m_width = header.width;
+    m_height = header.height;
+    m_tileSize = header.tileSize;
+    m_worldBounds = sf::FloatRect(
+        sf::Vector2f(0.f, 0.f),
+        sf::Vector2f(m_width * m_tileSize, m_height * m_tileSize)
+    );
+    setSeed(header.seed);
+    buildBackgroundVertices();
+    
+    startStreaming([this](ChunkCoord coord, std::vector<std::uint8_t>& tiles) {
+        if (!m_mapFile->decodeChunk(coord, tiles.data())) {
+            generateChunk(coord, tiles);
+        }
+    });
+    return true;
+}
+
+void World::updateStreaming(const sf::FloatRect& viewBounds)
+{
+    if (!m_streamer) return;
+    
+    // Shrink the preload margin if the view would not fit in the budget otherwise
+    int margin = m_streamingSettings.preloadMargin;
+    ChunkCoord first, last;
+    getChunkRange(viewBounds, margin, first, last);
+    while (margin > 0 &&
+           static_cast<std::size_t>((last.x - first.x) * (last.y - first.y)) > m_streamer->getMaxResidentChunks()) {
+        getChunkRange(viewBounds, --margin, first, last);
     }
     
-    std::cout << "World generated successfully!\n";
+    m_streamer->request(first, last);
+    m_streamer->update();
+}
+
+TileType World::getTileType(unsigned int x, unsigned int y) const
+{
+    if (m_streamer) {
+        ChunkCoord coord{static_cast<int>(x / ChunkSize), static_cast<int>(y / ChunkSize)};
+        const ResidentChunk& chunk = m_streamer->acquire(coord);
+        return static_cast<TileType>(chunk.tiles[(x % ChunkSize) + (y % ChunkSize) * ChunkSize]);
+    }
+    return static_cast<TileType>(m_tileTypes[x + static_cast<std::size_t>(y) * m_width]);
+}
+
+bool World::setTile(unsigned int x, unsigned int y, TileType type)
+{
+    if (x >= m_width || y >= m_height) {
+        return false;
+    }
+    
+    if (m_streamer) {
+        ResidentChunk& chunk = m_streamer->acquire({static_cast<int>(x / ChunkSize), static_cast<int>(y / ChunkSize)});
+        chunk.tiles[(x % ChunkSize) + (y % ChunkSize) * ChunkSize] = static_cast<std::uint8_t>(type);
+        chunk.modified = true;
+    } else {
+        storeTile(x, y, type);
+    }
+    
+    patchMesh(x, y, type);
+    return true;
+}
+
+void World::patchMesh(unsigned int x, unsigned int y, TileType type)
+{
+    // Chunks without a clean cached mesh pick the change up when they are next built
+    auto it = m_meshCache.find({static_cast<int>(x / ChunkSize), static_cast<int>(y / ChunkSize)});
+    if (it == m_meshCache.end() || it->second.dirty) {
+        return;
+    }
+    
+    unsigned int startX = (x / ChunkSize) * ChunkSize;
+    unsigned int startY = (y / ChunkSize) * ChunkSize;
+    unsigned int chunkWidth = std::min(startX + ChunkSize, m_width) - startX;
+    
+    sf::Vertex* quad = &it->second.vertices[((x - startX) + (y - startY) * chunkWidth) * 6];
+    writeTileQuad(quad, x, y, type);
+}
+
+void World::storeTile(unsigned int x, unsigned int y, TileType type)
+{
+    std::size_t index = x + static_cast<std::size_t>(y) * m_width;
+    m_tileTypes[index] = static_cast<std::uint8_t>(type);
+    
+    std::uint64_t bit = std::uint64_t(1) << (index & 63);
+    if (isTileWalkable(type)) {
+        m_walkable[index >> 6] |= bit;
+    } else {
+        m_walkable[index >> 6] &= ~bit;
+    }
 }
 
 void World::draw(sf::RenderTarget& target, const sf::FloatRect& viewBounds) const
 {
+    GAME_PROFILE_ZONE("World::draw");
+    
     // Draw background first (if loaded)
     if (m_hasBackground) {
         sf::RenderStates bgStates;
-        bgStates.texture = &m_backgroundTexture;
+        bgStates.texture = m_backgroundTexture.get();
         target.draw(m_backgroundVertices, bgStates);
     }
     
-    // Draw tileset (if loaded)
+    sf::RenderStates tileStates;
     if (m_hasTileset) {
-        sf::RenderStates tileStates;
-        tileStates.texture = &m_tilesetTexture;
-        target.draw(m_tileVertices, tileStates);
-    } else {
-        // Fallback: draw colored rectangles
-        int startX = std::max(0, static_cast<int>(viewBounds.position.x / m_tileSize) - 1);
-        int startY = std::max(0, static_cast<int>(viewBounds.position.y / m_tileSize) - 1);
-        int endX = std::min(static_cast<int>(m_width), 
-                            static_cast<int>((viewBounds.position.x + viewBounds.size.x) / m_tileSize) + 2);
-        int endY = std::min(static_cast<int>(m_height), 
-                            static_cast<int>((viewBounds.position.y + viewBounds.size.y) / m_tileSize) + 2);
-        
-        for (int y = startY; y < endY; ++y) {
-            for (int x = startX; x < endX; ++x) {
-                target.draw(m_tiles[y][x].shape);
+        tileStates.texture = m_tilesetTexture.get();
+    }
+    
+    // Only chunks overlapping the view are drawn; their meshes are built the first time they are seen
+    ++m_drawCounter;
+    ChunkCoord first, last;
+    getChunkRange(viewBounds, 0, first, last);
+    
+    for (int cy = first.y; cy < last.y; ++cy) {
+        for (int cx = first.x; cx < last.x; ++cx) {
+            ChunkCoord coord{cx, cy};
+            ChunkMesh& mesh = m_meshCache[coord];
+            
+            if (mesh.dirty) {
+                if (m_streamer) {
+                    // Not paged in yet, the streamer will have it in a frame or two
+                    const ResidentChunk* chunk = m_streamer->find(coord);
+                    if (!chunk) continue;
+                    buildChunkMesh(coord, chunk->tiles.data(), ChunkSize, mesh);
+                } else {
+                    std::size_t offset = cx * ChunkSize + static_cast<std::size_t>(cy) * ChunkSize * m_width;
+                    buildChunkMesh(coord, m_tileTypes.data() + offset, m_width, mesh);
+                }
             }
+            
+            mesh.lastDrawn = m_drawCounter;
+            target.draw(mesh.vertices, tileStates);
         }
     }
+    
+    pruneMeshCache();
 }
 
 bool World::isWalkable(const sf::Vector2f& position) const
 {
-    int tileX = static_cast<int>(position.x / m_tileSize);
-    int tileY = static_cast<int>(position.y / m_tileSize);
+    int tileX = static_cast<int>(std::floor(position.x / m_tileSize));
+    int tileY = static_cast<int>(std::floor(position.y / m_tileSize));
     
-    if (tileX < 0 || tileX >= static_cast<int>(m_width) || 
-        tileY < 0 || tileY >= static_cast<int>(m_height)) {
-        return false;
+    return !isTileBlocked(tileX, tileY);
+}
+
+bool World::isTileBlocked(int x, int y) const
+{
+    // Everything outside the map counts as solid
+    if (x < 0 || x >= static_cast<int>(m_width) || 
+        y < 0 || y >= static_cast<int>(m_height)) {
+        return true;
     }
     
-    return m_tiles[tileY][tileX].walkable;
+    if (m_streamer) {
+        return !isTileWalkable(getTileType(x, y));
+    }
+    
+    std::size_t index = x + static_cast<std::size_t>(y) * m_width;
+    return !((m_walkable[index >> 6] >> (index & 63)) & 1u);
 }
 
 bool World::checkCollision(const sf::FloatRect& bounds) const
 {
-    // Check all four corners of the bounding box
-    std::vector<sf::Vector2f> corners = {
-        sf::Vector2f(bounds.position.x, bounds.position.y),
-        sf::Vector2f(bounds.position.x + bounds.size.x, bounds.position.y),
-        sf::Vector2f(bounds.position.x, bounds.position.y + bounds.size.y),
-        sf::Vector2f(bounds.position.x + bounds.size.x, bounds.position.y + bounds.size.y)
-    };
-    
-    for (const auto& corner : corners) {
-        if (!isWalkable(corner)) {
-            return true; // Collision detected
+    // Every tile the box overlaps, not just the corners, so large entities can't straddle a wall
+    int startX = static_cast<int>(std::floor(bounds.position.x / m_tileSize));
+    int startY = static_cast<int>(std::floor(bounds.position.y / m_tileSize));
+    int endX = static_cast<int>(std::ceil((bounds.position.x + bounds.size.x) / m_tileSize));
+    int endY = static_cast<int>(std::ceil((bounds.position.y + bounds.size.y) / m_tileSize));
+    
+    for (int y = startY; y < std::max(endY, startY + 1); ++y) {
+        for (int x = startX; x < std::max(endX, startX + 1); ++x) {
+            if (isTileBlocked(x, y)) {
+                return true; // Collision detected
+            }
         }
     }
     
     return false;
 }
 
+SweepResult World::sweepBox(const sf::FloatRect& bounds, const sf::Vector2f& delta) const
+{
+    SweepResult result;
+    
+    float left   = bounds.position.x;
+    float top    = bounds.position.y;
+    float right  = left + bounds.size.x;
+    float bottom = top + bounds.size.y;
+    
+    // Broadphase: tiles covered by the box at its start and end positions
+    int startX = static_cast<int>(std::floor((std::min(left, left + delta.x)) / m_tileSize));
+    int startY = static_cast<int>(std::floor((std::min(top, top + delta.y)) / m_tileSize));
+    int endX = static_cast<int>(std::ceil((std::max(right, right + delta.x)) / m_tileSize));
+    int endY = static_cast<int>(std::ceil((std::max(bottom, bottom + delta.y)) / m_tileSize));
+    
+    const float inf = std::numeric_limits<float>::infinity();
+    
+    for (int y = startY; y < endY; ++y) {
+        for (int x = startX; x < endX; ++x) {
+            float tileLeft   = x * m_tileSize;
+            float tileTop    = y * m_tileSize;
+            float tileRight  = tileLeft + m_tileSize;
+            float tileBottom = tileTop + m_tileSize;
+            
+            // Slab test per axis: times at which the box starts and stops overlapping the tile
+            float entryX, exitX, entryY, exitY;
+            if (delta.x > 0.f) {
+                entryX = (tileLeft - right) / delta.x;
+                exitX  = (tileRight - left) / delta.x;
+            } else if (delta.x < 0.f) {
+                entryX = (tileRight - left) / delta.x;
+                exitX  = (tileLeft - right) / delta.x;
+            } else {
+                if (right <= tileLeft || left >= tileRight) continue;
+                entryX = -inf;
+                exitX  = inf;
+            }
+            
+            if (delta.y > 0.f) {
+                entryY = (tileTop - bottom) / delta.y;
+                exitY  = (tileBottom - top) / delta.y;
+            } else if (delta.y < 0.f) {
+                entryY = (tileBottom - top) / delta.y;
+                exitY  = (tileTop - bottom) / delta.y;
+            } else {
+                if (bottom <= tileTop || top >= tileBottom) continue;
+                entryY = -inf;
+                exitY  = inf;
+            }
+            
+            float entry = std::max(entryX, entryY);
+            float exit  = std::min(exitX, exitY);
+            
+            // No contact during this move, or the box already overlaps the tile (let it move out)
+            if (entry >= exit || entry < 0.f || entry > result.time) continue;
+            if (result.hit && entry == result.time) continue;
+            if (!isTileBlocked(x, y)) continue;
+            
+            result.hit = true;
+            result.time = entry;
+            if (entryX > entryY) {
+                result.normal = sf::Vector2f(delta.x > 0.f ? -1.f : 1.f, 0.f);
+            } else {
+                result.normal = sf::Vector2f(0.f, delta.y > 0.f ? -1.f : 1.f);
+            }
+        }
+    }
+    
+    return result;
+}
+
+sf::Vector2f World::moveAndSlide(const sf::FloatRect& bounds, const sf::Vector2f& delta) const
+{
+    // Keeps resolved boxes a hair away from walls so rounding never leaves them inside one
+    const float skin = 0.001f;
+    
+    sf::FloatRect box = bounds;
+    sf::Vector2f remaining = delta;
+    sf::Vector2f moved{0.f, 0.f};
+    
+    // At most one slide per axis plus the initial move
+    for (int i = 0; i < 3; ++i) {
+        if (remaining.x == 0.f && remaining.y == 0.f) break;
+        
+        SweepResult sweep = sweepBox(box, remaining);
+        sf::Vector2f step = remaining * sweep.time;
+        if (sweep.hit) {
+            step += sweep.normal * skin;
+        }
+        
+        moved += step;
+        box.position += step;
+        
+        if (!sweep.hit) break;
+        
+        // Slide: drop the part of the leftover motion that pushes into the surface
+        remaining *= (1.f - sweep.time);
+        float into = remaining.x * sweep.normal.x + remaining.y * sweep.normal.y;
+        remaining -= sweep.normal * into;
+    }
+    
+    return moved;
+}
+
 sf::Color World::getTileColor(TileType type) const
 {
     switch (type) {
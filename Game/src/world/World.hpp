@@ -1,64 +1,130 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include "../assets/AssetManager.hpp"
+#include "ChunkStreamer.hpp"
+#include "MapFile.hpp"
+#include "TileType.hpp"
+#include "WorldGenerator.hpp"
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 namespace game::world {
 
-enum class TileType {
-    Grass,
-    Water,
-    Stone,
-    Sand,
-    Wall
+// Render geometry for one chunk, derived from the tile grid when the chunk comes into view
+struct ChunkMesh {
+    sf::VertexArray vertices{sf::PrimitiveType::Triangles};
+    bool dirty = true;
+    std::uint64_t lastDrawn = 0;
 };
 
-struct Tile {
-    TileType type;
-    sf::RectangleShape shape;
-    bool walkable;
+// Result of sweeping a box through the tile grid
+struct SweepResult {
+    bool hit = false;
+    float time = 1.f;           // Fraction of the move completed before contact (0-1)
+    sf::Vector2f normal{0.f, 0.f}; // Normal of the blocking tile face
+};
+
+// Settings for paging chunks in and out around the camera instead of keeping the whole map resident
+struct StreamingSettings {
+    std::size_t memoryBudget = 16 * 1024 * 1024; // Bytes of tile data allowed to stay resident
+    int preloadMargin = 1;                        // Extra chunks loaded around the view
+    std::string cacheDirectory = "world_cache";   // Swap space for edited chunks that get paged out
 };
 
 class World {
 public:
     World(unsigned int width, unsigned int height, float tileSize = 32.f);
     
-    void generate(); // Generate a simple world
+    // Seed for generate() and streamed chunks; the same seed always produces the same map
+    void setSeed(std::uint64_t seed);
+    std::uint64_t getSeed() const { return m_seed; }
+    
+    void generate(unsigned int threadCount = 0); // Generate the whole map (0 threads = one per core)
     void draw(sf::RenderTarget& target, const sf::FloatRect& viewBounds) const;
     
     bool isWalkable(const sf::Vector2f& position) const;
+    
+    // Change one tile (destructible terrain, editing). Only that tile's quad is
+    // patched in the render cache; returns false if (x, y) is outside the map.
+    bool setTile(unsigned int x, unsigned int y, TileType type);
     sf::FloatRect getWorldBounds() const { return m_worldBounds; }
+    float getTileSize() const { return m_tileSize; }
     
-    // Collision check
+    // Collision check (true if any tile the box covers is blocked)
     bool checkCollision(const sf::FloatRect& bounds) const;
     
-    // Texture loading (for Aseprite exports)
-    bool loadBackgroundTexture(const std::string& texturePath);
-    bool loadTileset(const std::string& texturePath, const sf::Vector2i& tileSize);
+    // Swept collision: tests every tile the box passes through while moving by `delta`.
+    // Neither call allocates.
+    SweepResult sweepBox(const sf::FloatRect& bounds, const sf::Vector2f& delta) const;
+    sf::Vector2f moveAndSlide(const sf::FloatRect& bounds, const sf::Vector2f& delta) const; // Returns the allowed displacement
+    
+    // Texture loading (for Aseprite exports). Waits for the asset manager if the file is still
+    // decoding, so request it early to overlap the load with world generation.
+    bool loadBackgroundTexture(game::assets::AssetManager& assets, const std::string& texturePath);
+    bool loadTileset(game::assets::AssetManager& assets, const std::string& texturePath, const sf::Vector2i& tileSize);
+    
+    // Persistence. load() memory-maps the file and switches to streaming mode,
+    // so chunks are only decoded when they are first needed.
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+    
+    // Streaming mode: tiles are generated per chunk on a background thread as the view approaches
+    void enableStreaming(const StreamingSettings& settings = StreamingSettings());
+    bool isStreaming() const { return m_streamer != nullptr; }
+    void updateStreaming(const sf::FloatRect& viewBounds); // Call once per frame
+    
+    // Chunk size in tiles (per side)
+    static constexpr unsigned int ChunkSize = 16;
     
 private:
     unsigned int m_width;
     unsigned int m_height;
     float m_tileSize;
     
-    std::vector<std::vector<Tile>> m_tiles;
+    // Authoritative tile grid, row-major: one type byte and one walkability bit per tile
+    std::vector<std::uint8_t> m_tileTypes;
+    std::vector<std::uint64_t> m_walkable;
     sf::FloatRect m_worldBounds;
     
     // Texture rendering
-    sf::Texture m_backgroundTexture;
-    sf::Texture m_tilesetTexture;
+    game::assets::TextureHandle m_backgroundTexture;
+    game::assets::TextureHandle m_tilesetTexture;
     bool m_hasBackground = false;
     bool m_hasTileset = false;
     
     mutable sf::VertexArray m_backgroundVertices;
-    mutable sf::VertexArray m_tileVertices;
+    
+    // Meshes for chunks that were on screen recently; everything else has no render geometry
+    mutable std::unordered_map<ChunkCoord, ChunkMesh, ChunkCoordHash> m_meshCache;
+    mutable std::uint64_t m_drawCounter = 0;
+    static constexpr std::size_t MaxCachedMeshes = 128;
+    
+    // Streaming mode (replaces m_tileTypes and m_walkable when enabled).
+    // Declared after everything the worker thread reads so it is joined first.
+    std::uint64_t m_seed;
+    WorldGenerator m_generator;
+    std::unique_ptr<MapFile> m_mapFile;
+    StreamingSettings m_streamingSettings;
+    std::unique_ptr<ChunkStreamer> m_streamer;
     
     sf::Vector2i m_tilesetTileSize{32, 32};
     int m_tilesPerRow = 0;
     
     void buildBackgroundVertices();
-    void buildTileVertices();
+    void buildChunkMesh(const ChunkCoord& coord, const std::uint8_t* tiles, unsigned int stride, ChunkMesh& mesh) const;
+    void pruneMeshCache() const;
+    void patchMesh(unsigned int x, unsigned int y, TileType type);
+    void writeTileQuad(sf::Vertex* quad, unsigned int x, unsigned int y, TileType type) const;
+    void getChunkRange(const sf::FloatRect& viewBounds, int margin, ChunkCoord& first, ChunkCoord& last) const;
+    
+    TileType getTileType(unsigned int x, unsigned int y) const;
+    bool isTileBlocked(int x, int y) const;
+    void storeTile(unsigned int x, unsigned int y, TileType type);
+    void generateChunk(const ChunkCoord& coord, std::vector<std::uint8_t>& tiles) const;
+    void startStreaming(ChunkStreamer::Generator source);
     
     sf::Color getTileColor(TileType type) const;
     bool isTileWalkable(TileType type) const;
@@ -0,0 +1,185 @@
+#include "WorldGenerator.hpp"
+#include "../core/ThreadPool.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace game::world {
+
+namespace {
+
+// Independent noise streams so the layers don't correlate
+enum Stream : std::uint64_t {
+    Elevation = 1,
+    Moisture,
+    River,
+    Rock,
+    Detail
+};
+
+// SplitMix64 finaliser
+std::uint64_t mix64(std::uint64_t z)
+{
+    z += 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+std::uint64_t hashCoords(std::uint64_t seed, std::uint64_t stream, std::int64_t x, std::int64_t y)
+{
+    // Large odd multipliers spread x and y over all bits before a single finalising mix
+    std::uint64_t key = seed ^ (stream * 0xD6E8FEB86659FD93ull);
+    return mix64(key ^ (static_cast<std::uint64_t>(x) * 0x9E3779B97F4A7C15ull)
+                     ^ (static_cast<std::uint64_t>(y) * 0xC2B2AE3D27D4EB4Full));
+}
+
+// Top 24 bits as a float in [0, 1)
+float toUnit(std::uint64_t bits)
+{
+    return static_cast<float>(bits >> 40) * (1.f / 16777216.f);
+}
+
+// Counter-based generator: value n is a pure function of (key, n), so the
+// output doesn't depend on how many values other chunks or threads consumed
+class ChunkRng {
+public:
+    ChunkRng(std::uint64_t seed, int chunkX, int chunkY)
+        : m_key(hashCoords(seed, Stream::Detail, chunkX, chunkY))
+    {}
+
+    float unitAt(std::uint64_t counter) const { return toUnit(mix64(m_key + counter * 0x9E3779B97F4A7C15ull)); }
+
+private:
+    std::uint64_t m_key;
+};
+
+} // namespace
+
+WorldGenerator::WorldGenerator(std::uint64_t seed, unsigned int width, unsigned int height)
+    : m_seed(seed)
+    , m_width(width)
+    , m_height(height)
+{
+}
+
+void WorldGenerator::generateChunk(int chunkX, int chunkY, unsigned int chunkSize, std::uint8_t* tiles, unsigned int stride) const
+{
+    ChunkRng rng(m_seed, chunkX, chunkY);
+
+    unsigned int startX = chunkX * chunkSize;
+    unsigned int startY = chunkY * chunkSize;
+    unsigned int endX = std::min(startX + chunkSize, m_width);
+    unsigned int endY = std::min(startY + chunkSize, m_height);
+
+    for (unsigned int y = startY; y < endY; ++y) {
+        std::uint8_t* row = tiles + (y - startY) * stride;
+        for (unsigned int x = startX; x < endX; ++x) {
+            // Counter is the tile's index inside the chunk, not a running count
+            float roll = rng.unitAt((x - startX) + (y - startY) * chunkSize);
+            row[x - startX] = static_cast<std::uint8_t>(generateTile(x, y, roll));
+        }
+    }
+}
+
+void WorldGenerator::generate(std::uint8_t* tiles, unsigned int chunkSize, core::ThreadPool& pool) const
+{
+    unsigned int chunksX = (m_width + chunkSize - 1) / chunkSize;
+    unsigned int chunksY = (m_height + chunkSize - 1) / chunkSize;
+
+    pool.parallelFor(static_cast<std::size_t>(chunksX) * chunksY, [&](std::size_t i) {
+        unsigned int cx = static_cast<unsigned int>(i % chunksX);
+        unsigned int cy = static_cast<unsigned int>(i / chunksX);
+        std::size_t offset = cx * chunkSize + static_cast<std::size_t>(cy) * chunkSize * m_width;
+        generateChunk(cx, cy, chunkSize, tiles + offset, m_width);
+    });
+}
+
+TileType WorldGenerator::generateTile(unsigned int x, unsigned int y, float detailRoll) const
+{
+    // Create borders (walls)
+    if (x == 0 || y == 0 || x == m_width - 1 || y == m_height - 1) {
+        return TileType::Wall;
+    }
+
+    // Keep a clearing around the spawn point in the middle of the map
+    float dx = static_cast<float>(x) - m_width / 2.f;
+    float dy = static_cast<float>(y) - m_height / 2.f;
+    if (dx * dx + dy * dy < 36.f) {
+        return TileType::Grass;
+    }
+
+    float fx = static_cast<float>(x);
+    float fy = static_cast<float>(y);
+
+    // Lakes in the lowlands, rivers along a thin band of a slow noise field
+    float elevation = fbm(Stream::Elevation, fx / 48.f, fy / 48.f, 4);
+    if (elevation < 0.28f) {
+        return TileType::Water;
+    }
+
+    float river = fbm(Stream::River, fx / 96.f, fy / 96.f, 3);
+    if (std::abs(river - 0.5f) < 0.012f) {
+        return TileType::Water;
+    }
+
+    // Rocky outcrops with solid walls at their core
+    float rock = fbm(Stream::Rock, fx / 20.f, fy / 20.f, 3);
+    if (rock > 0.74f) {
+        return TileType::Wall;
+    }
+    if (rock > 0.68f) {
+        return TileType::Stone;
+    }
+
+    // Dry biomes are sand, everything else grass with the odd boulder
+    float moisture = fbm(Stream::Moisture, fx / 64.f, fy / 64.f, 3);
+    if (moisture < 0.36f) {
+        return TileType::Sand;
+    }
+    if (detailRoll < 0.02f) {
+        return TileType::Stone;
+    }
+    return TileType::Grass;
+}
+
+float WorldGenerator::fbm(std::uint64_t stream, float x, float y, int octaves) const
+{
+    float sum = 0.f;
+    float amplitude = 0.5f;
+    float total = 0.f;
+
+    for (int i = 0; i < octaves; ++i) {
+        sum += valueNoise(stream + i * 16, x, y) * amplitude;
+        total += amplitude;
+        x *= 2.f;
+        y *= 2.f;
+        amplitude *= 0.5f;
+    }
+
+    return sum / total;
+}
+
+float WorldGenerator::valueNoise(std::uint64_t stream, float x, float y) const
+{
+    float fx = std::floor(x);
+    float fy = std::floor(y);
+    auto ix = static_cast<std::int64_t>(fx);
+    auto iy = static_cast<std::int64_t>(fy);
+
+    // Smoothstep between the four lattice corners
+    float tx = x - fx;
+    float ty = y - fy;
+    tx = tx * tx * (3.f - 2.f * tx);
+    ty = ty * ty * (3.f - 2.f * ty);
+
+    float v00 = toUnit(hashCoords(m_seed, stream, ix,     iy));
+    float v10 = toUnit(hashCoords(m_seed, stream, ix + 1, iy));
+    float v01 = toUnit(hashCoords(m_seed, stream, ix,     iy + 1));
+    float v11 = toUnit(hashCoords(m_seed, stream, ix + 1, iy + 1));
+
+    float top    = v00 + (v10 - v00) * tx;
+    float bottom = v01 + (v11 - v01) * tx;
+    return top + (bottom - top) * ty;
+}
+
+} // namespace game::world
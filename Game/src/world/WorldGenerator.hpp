@@ -0,0 +1,39 @@
+#pragma once
+#include "TileType.hpp"
+#include <cstdint>
+
+namespace game::core {
+class ThreadPool;
+}
+
+namespace game::world {
+
+// Noise-based terrain: biomes, lakes, rivers and rock/wall clusters.
+// Every tile is a pure function of the seed and its coordinates, and the
+// per-tile detail comes from a counter-based RNG keyed by chunk coordinates,
+// so chunks can be generated in any order on any number of threads and the
+// map is still bit-identical for the same seed.
+class WorldGenerator {
+public:
+    WorldGenerator(std::uint64_t seed, unsigned int width, unsigned int height);
+
+    // Fill the chunkSize x chunkSize block starting at tile (chunkX * chunkSize, chunkY * chunkSize).
+    // Rows are `stride` bytes apart; tiles past the map edge are left untouched. Thread-safe.
+    void generateChunk(int chunkX, int chunkY, unsigned int chunkSize, std::uint8_t* tiles, unsigned int stride) const;
+
+    // Fill a whole width * height row-major map, one chunk per work item
+    void generate(std::uint8_t* tiles, unsigned int chunkSize, core::ThreadPool& pool) const;
+
+    std::uint64_t getSeed() const { return m_seed; }
+
+private:
+    TileType generateTile(unsigned int x, unsigned int y, float detailRoll) const;
+    float fbm(std::uint64_t stream, float x, float y, int octaves) const;
+    float valueNoise(std::uint64_t stream, float x, float y) const;
+
+    std::uint64_t m_seed;
+    unsigned int m_width;
+    unsigned int m_height;
+};
+
+} // namespace game::world
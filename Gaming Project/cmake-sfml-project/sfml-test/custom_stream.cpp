@@ -50,11 +50,9 @@ protected:
         std::size_t remaining = m_sampleCount - m_currentSample;
         std::size_t count = std::min(samplesPerChunk, remaining);
 
-        m_tempSamples.assign(m_samples + m_currentSample,
-                             m_samples + m_currentSample + count);
-
-        data.samples = m_tempSamples.data();
-        data.sampleCount = m_tempSamples.size();
+        // The buffer outlives the stream, so point SFML straight at it instead of copying
+        data.samples = m_samples + m_currentSample;
+        data.sampleCount = count;
 
         m_currentSample += count;
         return true;
@@ -75,7 +73,6 @@ private:
     std::size_t m_sampleCount = 0;
     std::size_t m_currentSample = 0;
     bool m_loop;
-    std::vector<sf::Int16> m_tempSamples;
 };
 
 int main() {